@@ -0,0 +1,61 @@
+/**
+ * Generated by tools/pack_assets.py from data. Do not edit.
+ */
+#pragma once
+
+#include <DemobotServer.h>
+
+
+/** /app.cdb14c12.js: 231 bytes, 157 stored gzipped. */
+const uint8_t demobotAssets_0_app_cdb14c12_js[] PROGMEM = {
+    0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0x75, 0x8e, 0x31, 0x0e, 0xc2, 0x30,
+    0x0c, 0x45, 0xf7, 0x9c, 0xc2, 0xca, 0x94, 0x2c, 0xe1, 0x00, 0x11, 0x0b, 0x88, 0x81, 0x63, 0xa0,
+    0xc4, 0x6d, 0x23, 0x8a, 0x53, 0x25, 0x8e, 0x54, 0x84, 0x7a, 0x77, 0x62, 0x10, 0x62, 0xea, 0x9f,
+    0xec, 0xef, 0xf7, 0xad, 0x1f, 0x73, 0x68, 0x0f, 0x24, 0x76, 0x23, 0xf2, 0x65, 0x46, 0x19, 0x4f,
+    0xcf, 0x6b, 0x34, 0x7a, 0x49, 0x34, 0x6a, 0xeb, 0x32, 0x85, 0x39, 0x85, 0x3b, 0x1c, 0x61, 0x68,
+    0x14, 0x38, 0x65, 0x02, 0x63, 0xe1, 0xa5, 0xa0, 0x6b, 0x40, 0x0e, 0x93, 0xd1, 0x87, 0x2f, 0xfa,
+    0xb1, 0x44, 0x8e, 0x27, 0x24, 0xf3, 0xc7, 0x0b, 0xd6, 0x25, 0x53, 0xc5, 0x1e, 0x83, 0x82, 0xdc,
+    0x0a, 0xc1, 0xcf, 0x72, 0x8c, 0x2b, 0x1b, 0xeb, 0x61, 0xdb, 0x8f, 0x0b, 0x22, 0xd1, 0xb8, 0xd7,
+    0xb4, 0xf2, 0x8d, 0x5b, 0xed, 0x5d, 0x85, 0x3c, 0x67, 0xe2, 0x7e, 0xe9, 0x7d, 0x65, 0x93, 0xc7,
+    0x5e, 0x6d, 0x5e, 0xbd, 0x01, 0x35, 0xfc, 0x44, 0xe6, 0xe7, 0x00, 0x00, 0x00,
+};
+
+/** /index.html: 397 bytes, 263 stored gzipped. */
+const uint8_t demobotAssets_1_index_html[] PROGMEM = {
+    0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0x75, 0x50, 0xb1, 0x6e, 0xc3, 0x20,
+    0x14, 0xdc, 0xf3, 0x15, 0x94, 0xb9, 0xb6, 0xe5, 0xb4, 0x8d, 0x5a, 0x09, 0xbc, 0x24, 0x9d, 0x9b,
+    0xa1, 0x4b, 0x47, 0x0c, 0x2f, 0xe5, 0xb5, 0x18, 0x10, 0x3c, 0x27, 0xca, 0xdf, 0x97, 0x1a, 0x47,
+    0xea, 0x52, 0x86, 0x87, 0xb8, 0x3b, 0xdd, 0x1d, 0x4f, 0xdc, 0x1d, 0xde, 0xf6, 0xef, 0x1f, 0xc7,
+    0x57, 0x66, 0x69, 0x72, 0xc3, 0x46, 0xdc, 0x2e, 0x50, 0x66, 0xd8, 0xb0, 0x72, 0xc4, 0x04, 0xa4,
+    0x98, 0xb6, 0x2a, 0x65, 0x20, 0xc9, 0x67, 0x3a, 0x35, 0xcf, 0xfc, 0x2f, 0xe5, 0xd5, 0x04, 0x92,
+    0x9f, 0x11, 0x2e, 0x31, 0x24, 0xe2, 0x4c, 0x07, 0x4f, 0xe0, 0x8b, 0xf4, 0x82, 0x86, 0xac, 0x34,
+    0x70, 0x46, 0x0d, 0xcd, 0xf2, 0xb8, 0x67, 0xe8, 0x91, 0x50, 0xb9, 0x26, 0x6b, 0xe5, 0x40, 0xf6,
+    0x37, 0x23, 0x42, 0x72, 0x30, 0x1c, 0x60, 0x0a, 0x63, 0x20, 0xb6, 0x2f, 0x0e, 0x29, 0x38, 0x76,
+    0x54, 0x1e, 0x9c, 0xe8, 0x2a, 0x59, 0x85, 0x0e, 0xfd, 0x37, 0x4b, 0xe0, 0x24, 0xcf, 0x74, 0x75,
+    0x90, 0x2d, 0x40, 0x89, 0xb4, 0x09, 0x4e, 0x92, 0x77, 0x0b, 0xd4, 0xee, 0x46, 0x78, 0xd9, 0xee,
+    0x1e, 0x9e, 0x5a, 0x9d, 0x73, 0xf1, 0x17, 0x5d, 0xfd, 0x8b, 0x18, 0x83, 0xb9, 0xae, 0x2e, 0xb6,
+    0xff, 0x2f, 0xab, 0x30, 0x55, 0x32, 0xce, 0x44, 0xc1, 0x33, 0x34, 0x92, 0x47, 0xf4, 0x9f, 0x7c,
+    0x38, 0x96, 0x29, 0xba, 0x0a, 0xaf, 0x9a, 0xb8, 0xd0, 0x99, 0x14, 0xcd, 0x25, 0x49, 0x74, 0x71,
+    0xc5, 0xb3, 0x4e, 0x18, 0x89, 0xe5, 0xa4, 0x4b, 0x29, 0x15, 0x63, 0xab, 0xcd, 0xd8, 0x3f, 0xea,
+    0x7e, 0xdb, 0x7e, 0x2d, 0xba, 0xca, 0xff, 0x56, 0xab, 0x9d, 0x4a, 0xec, 0xb2, 0xf5, 0x1f, 0xf9,
+    0x60, 0xf2, 0x72, 0x8d, 0x01, 0x00, 0x00,
+};
+
+/** /style.6be92635.css: 113 bytes, 108 stored gzipped. */
+const uint8_t demobotAssets_2_style_6be92635_css[] PROGMEM = {
+    0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0x4b, 0xca, 0x4f, 0xa9, 0x54, 0xa8,
+    0xe6, 0x52, 0x00, 0x82, 0xb4, 0xfc, 0xbc, 0x12, 0xdd, 0xb4, 0xc4, 0xdc, 0xcc, 0x9c, 0x4a, 0x2b,
+    0x85, 0xe2, 0xc4, 0xbc, 0x62, 0xdd, 0xe2, 0xd4, 0xa2, 0xcc, 0x34, 0x6b, 0xb0, 0x64, 0x6e, 0x62,
+    0x51, 0x7a, 0x66, 0x9e, 0x95, 0x82, 0x51, 0x6a, 0xae, 0x35, 0x57, 0x2d, 0x17, 0x57, 0x52, 0x69,
+    0x49, 0x49, 0x7e, 0x1e, 0xb2, 0xce, 0xe2, 0xcc, 0xaa, 0x54, 0x2b, 0x05, 0x43, 0x3d, 0x53, 0x90,
+    0x0a, 0x90, 0x68, 0x41, 0x62, 0x4a, 0x4a, 0x66, 0x5e, 0xba, 0x95, 0x82, 0x01, 0x48, 0x4c, 0xc1,
+    0x10, 0xa2, 0x13, 0x00, 0x2a, 0xa4, 0x20, 0x71, 0x71, 0x00, 0x00, 0x00,
+};
+
+const DemobotAsset demobotAssets[] = {
+    {"/app.cdb14c12.js", "application/javascript", "\"cdb14c12c3261ea4\"", demobotAssets_0_app_cdb14c12_js, 157, true, true},
+    {"/index.html", "text/html", "\"ac27c771ec808fc0\"", demobotAssets_1_index_html, 263, true, false},
+    {"/style.6be92635.css", "text/css", "\"6be92635199bdb12\"", demobotAssets_2_style_6be92635_css, 108, true, true}
+};
+
+const int demobotAssetsCount = 3;
@@ -0,0 +1,52 @@
+/**
+ * Author: agent
+ * Last Modified: 10/18/26
+ * Project: Dancebot
+ * File: DemobotAssetsExample.ino
+ * Description: Example sketch for serving a web control panel from flash.
+ * DemobotAssets.h is generated from the data directory with:
+ *     python3 tools/pack_assets.py examples/DemobotAssetsExample/data \
+ *         examples/DemobotAssetsExample/DemobotAssets.h
+ * Organization: UT IEEE RAS
+ */
+#include <Arduino.h>
+#include <DemobotNetwork.h>
+#include <DemobotServer.h>
+#include "DemobotAssets.h"
+
+
+/** Network instantiation */
+DemobotNetwork *network;
+DemobotServer *server;
+
+
+void onPing(AsyncWebServerRequest *request) {
+    request->send(200, "text/plain", "Pong");
+}
+
+void onNotFound(AsyncWebServerRequest *request) {
+    request->send(404, "text/plain", "404 Not Found.");
+}
+
+void setup() {
+    Serial.begin(115200);
+    Serial.println("\nDemobotAssetsExample.ino.");
+    /* Give some time to open up the serial monitor. */
+    delay(3000);
+
+    /* Start up the network. */
+    network = new DemobotNetwork(DemobotNetwork::MOTHERSHIP);
+    network->connectNetwork();
+
+    /* Serve the control panel at '/' along with the endpoints it calls. */
+    server = new DemobotServer();
+    server->mountAssets(demobotAssets, demobotAssetsCount);
+    server->addGETEndpoint(String("/ping"), onPing);
+    server->addOnNotFound(onNotFound);
+    server->startServer();
+
+    Serial.print("Control panel at http://");
+    Serial.println(network->IpAddress2String(network->getIPAddress()));
+}
+
+void loop() {}
@@ -0,0 +1,5 @@
+document.getElementById("ping").onclick = function () {
+    fetch("/ping")
+        .then(function (response) { return response.text(); })
+        .then(function (text) { document.getElementById("status").textContent = text; });
+};
@@ -0,0 +1,120 @@
+/**
+ * Author: agent
+ * Last Modified: 10/18/26
+ * Project: Dancebot
+ * File: DemobotClientBenchmark.ino
+ * Description: Example sketch for measuring client throughput. Sends a batch
+ * of GET requests using a fresh client per message (one connection each), then
+ * the same batch over a single pooled client, and prints successful
+ * messages/s, failures, and TCP handshakes for both. The pooled run only
+ * reuses its socket if the server keeps it open, which its handshake count
+ * shows.
+ * Organization: UT IEEE RAS
+ */
+#include <Arduino.h>
+#include <DemobotNetwork.h>
+#include <DemobotServer.h>
+#include <DemobotClient.h>
+
+
+#define NUM_MESSAGES 200
+
+/** Network instantiation */
+DemobotNetwork *network;
+DemobotServer *server;
+DemobotClient *client;
+
+void onPing(AsyncWebServerRequest *request) {
+    request->send(200, "text/plain", "OK");
+}
+
+/** Responses, counted from the AsyncTCP task. Only OKs count as messages. */
+volatile unsigned long numSuccesses = 0;
+volatile unsigned long numFailures = 0;
+
+void onPingClient(void *optParm, asyncHTTPrequest *request, int readyState) {
+    if (readyState != 4) return;
+    if (request->responseHTTPcode() == 200) {
+        numSuccesses++;
+    } else {
+        numFailures++;
+    }
+}
+
+void printResult(
+    const char *name,
+    unsigned long messages,
+    unsigned long failures,
+    unsigned long elapsed,
+    unsigned long handshakes) {
+    Serial.print(name);
+    Serial.print(": ");
+    Serial.print(messages * 1000.0 / elapsed);
+    Serial.print(" messages/s, ");
+    Serial.print(failures);
+    Serial.print(" failures, ");
+    Serial.print(handshakes);
+    Serial.println(" handshakes.");
+}
+
+void setup() {
+    Serial.begin(115200);
+    Serial.println("\nDemobotClientBenchmark.ino.");
+    /* Give some time to open up the serial monitor. */
+    delay(3000);
+
+    /* Start up the network and a local server to talk to. */
+    network = new DemobotNetwork(DemobotNetwork::DANCEBOT_1);
+    network->connectNetwork();
+    server = new DemobotServer();
+    server->addGETEndpoint(String("/ping"), onPing);
+    server->startServer();
+    delay(100);
+
+    String url = String("http://" + network->IpAddress2String(network->getIPAddress()) + ":80/ping");
+    String keys[1] = {String("ID")};
+    String vals[1] = {String("0")};
+
+    /* Before: a new client, and so a new connection, for every message. The
+     * client is only deleted once handleConnections() has taken the
+     * connection back from the AsyncTCP task. */
+    unsigned long handshakes = 0;
+    numSuccesses = 0;
+    numFailures = 0;
+    unsigned long start = millis();
+    for (int i = 0; i < NUM_MESSAGES; i++) {
+        client = new DemobotClient();
+        if (client->sendGETRequest(url, keys, vals, 1, onPingClient)) {
+            while (client->getMessageCount() == 0) {
+                client->handleConnections();
+                delay(1);
+            }
+            handshakes += client->getHandshakeCount();
+        } else {
+            numFailures++;
+        }
+        delete client;
+    }
+    printResult("New connection per message", numSuccesses, numFailures, millis() - start, handshakes);
+
+    /* After: one client that queues requests on a single keep-alive connection. */
+    client = new DemobotClient();
+    numSuccesses = 0;
+    numFailures = 0;
+    start = millis();
+    int sent = 0;
+    while (client->getMessageCount() < (unsigned long)NUM_MESSAGES) {
+        /* A full queue just means we wait for the connection to free up. */
+        if (sent < NUM_MESSAGES &&
+            client->sendGETRequest(url, keys, vals, 1, onPingClient)) {
+            sent++;
+        }
+        client->handleConnections();
+        delay(1);
+    }
+    printResult("Pooled keep-alive connection", numSuccesses, numFailures, millis() - start, client->getHandshakeCount());
+}
+
+void loop() {
+    client->handleConnections();
+}
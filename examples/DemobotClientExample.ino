@@ -107,10 +107,9 @@ void setup() {
     String vals[numArgs] = {String("0"), String("50")};
     client->sendGETRequest(url + "robotJoin", keys, vals, numArgs, onRobotJoinClient);
 
-    /* An asynchronous call may need a little bit of time to get ready. */
-    delay(100);
-
-    /* Send a POST request to robotJoinPOST, looking for a response. */
+    /* Send a POST request to robotJoinPOST, looking for a response. This
+     * reuses the connection from the GET request, and is queued until the GET
+     * request gets its response. */
     Serial.println("\nAttempting to join a robot to the server with POST.");
     client->sendPOSTRequest(url + "robotJoinPOST", keys, vals, 1, onRobotJoinClient);
 
@@ -118,4 +117,7 @@ void setup() {
     delay(100);
 }
 
-void loop() {}
+void loop() {
+    /* Send queued requests and close idle connections. */
+    client->handleConnections();
+}
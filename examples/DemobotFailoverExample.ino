@@ -0,0 +1,62 @@
+/**
+ * Author: agent
+ * Last Modified: 10/18/26
+ * Project: Dancebot
+ * File: DemobotFailoverExample.ino
+ * Description: Example sketch for keeping the network up when the host robot
+ * drops. Flash it onto several robots with different IDs, then power off the
+ * host; another robot takes over and the rest rejoin it.
+ * Organization: UT IEEE RAS
+ */
+#include <Arduino.h>
+#include <DemobotNetwork.h>
+#include <DemobotServer.h>
+#include <DemobotClient.h>
+#include <DemobotFailover.h>
+
+
+/** Change this for each robot. */
+#define ROBOT_ID DemobotNetwork::DANCEBOT_1
+
+/** Network instantiation */
+DemobotNetwork *network;
+DemobotServer *server;
+DemobotClient *client;
+DemobotFailover *failover;
+
+bool wasHost = false;
+
+
+void setup() {
+    Serial.begin(115200);
+    Serial.println("\nDemobotFailoverExample.ino.");
+    /* Give some time to open up the serial monitor. */
+    delay(3000);
+
+    /* Start up the network. */
+    network = new DemobotNetwork(ROBOT_ID);
+    network->connectNetwork();
+
+    /* Every robot runs a server so any of them can take over as host. */
+    server = new DemobotServer();
+    client = new DemobotClient();
+    failover = new DemobotFailover(ROBOT_ID, network, server, client);
+    failover->addHeartbeatEndpoint();
+    server->startServer();
+
+    wasHost = failover->isHost();
+    Serial.print("Starting as host [1=T|0=F]: ");
+    Serial.println(wasHost);
+}
+
+void loop() {
+    failover->handleFailover();
+    client->handleConnections();
+
+    /* Report the recovery time whenever this robot takes over. */
+    if (failover->isHost() && !wasHost) {
+        Serial.print("Took over as host. Recovery time (ms): ");
+        Serial.println(failover->getRecoveryTime());
+    }
+    wasHost = failover->isHost();
+}
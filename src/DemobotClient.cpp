@@ -1,7 +1,7 @@
 /**
  * File: DemobotClient.h
  * Author: Matthew Yu
- * Last Modified: 03/16/21
+ * Last Modified: 10/18/26
  * Project: Demobots General
  * Organization: UT IEEE RAS
  * Description: Implements definitions for the DemobotClient class, which
@@ -10,38 +10,49 @@
 #include "DemobotClient.h"
 
 
+/** Public methods. */
+
 DemobotClient::DemobotClient() {
-    _request = NULL;
+    for (int i = 0; i < MAX_CONNECTIONS; i++) {
+        _connections[i].request = nullptr;
+        _connections[i].host = "";
+        _connections[i].handler = nullptr;
+        _connections[i].isBusy = false;
+        _connections[i].isComplete = false;
+        _connections[i].isClosing = false;
+        _connections[i].openingTask = nullptr;
+        _connections[i].responseCode = -1;
+        _connections[i].lastActivity = 0;
+        _connections[i].queueHead = 0;
+        _connections[i].queueSize = 0;
+    }
+    _timeout = 0;
+    _messageCount = 0;
+    _handshakeCount = 0;
 }
 
 int DemobotClient::pingServer(const String url) {
     /* Send a root level GET request to see if the server exists. */
-    bool isFinished = false;
-    int responseCode = -1;
-
-    /* Request must be aborted if it was previously generated, since successive
-     * calls to the same endpoint don't seem to ever close. */
-    if (_request != NULL) _request->abort();
-    else _request = new asyncHTTPrequest();
-
-    _request->onReadyStateChange(
-        [&responseCode, &isFinished](void *optParam, asyncHTTPrequest *request, int readyState) {
-            if (readyState == 4) {
-                isFinished = true;
-                responseCode = request->responseHTTPcode();
-            }
-        }
-    );
-    if (_request->readyState() == 0 || _request->readyState() == 4) {
-        _request->open("GET", url.c_str());
-        _request->send();
+    String host = getHost(url);
+    if (host.length() == 0) return -1;
+    Connection *connection = getConnection(host);
+    if (connection == nullptr) return -1;
+
+    /* Let anything already in flight or queued for this host go first. */
+    while (connection->isBusy || connection->queueSize > 0) {
+        handleConnections();
+        delay(PING_POLL_WAIT);
     }
 
-    while (!isFinished) delay(100);
-    return responseCode;
+    if (!dispatchRequest(connection, PendingRequest{"GET", url, "", nullptr})) return -1;
+    while (connection->isBusy) {
+        handleConnections();
+        delay(PING_POLL_WAIT);
+    }
+    return connection->responseCode;
 }
 
-void DemobotClient::sendGETRequest(
+bool DemobotClient::sendGETRequest(
     const String url,
     const String keys[],
     const String vals[],
@@ -60,20 +71,10 @@ void DemobotClient::sendGETRequest(
         }
     }
 
-    /* Request must be aborted if it was previously generated, since successive
-     * calls to the same endpoint don't seem to ever close. */
-    if (_request != NULL) _request->abort();
-    else _request = new asyncHTTPrequest();
-
-    /* Set the response handler and send the request. */
-    _request->onReadyStateChange(handler);
-    if (_request->readyState() == 0 || _request->readyState() == 4) {
-        _request->open("GET", queryPath.c_str());
-        _request->send();
-    }
+    return submitRequest("GET", queryPath, "", handler);
 }
 
-void DemobotClient::sendPOSTRequest(
+bool DemobotClient::sendPOSTRequest(
     const String url,
     const String keys[],
     const String vals[],
@@ -91,21 +92,262 @@ void DemobotClient::sendPOSTRequest(
         }
     }
 
-    /* Request must be aborted if it was previously generated, since successive
-     * calls to the same endpoint don't seem to ever close. */
-    if (_request != NULL) _request->abort();
-    else _request = new asyncHTTPrequest();
+    return submitRequest("POST", url, data, handler);
+}
+
+void DemobotClient::setTimeout(const int seconds) {
+    _timeout = seconds;
+}
 
-    /* Set the response handler and send the request. */
-    _request->onReadyStateChange(handler);
-    if (_request->readyState() == 0 || _request->readyState() == 4) {
-        _request->open("POST", url.c_str());
-        _request->setReqHeader("Content-Type", "application/x-www-form-urlencoded");
-        _request->setReqHeader("Content-Length", data.length());
-        _request->send(data);
+void DemobotClient::handleConnections() {
+    for (int i = 0; i < MAX_CONNECTIONS; i++) {
+        Connection *connection = &_connections[i];
+        if (connection->request == nullptr) continue;
+
+        /* Take back connections the AsyncTCP task has finished with. */
+        if (connection->isBusy) {
+            if (!connection->isComplete) continue;
+
+            /* An aborted request has now been reported, so it's safe to free. */
+            if (connection->isClosing) {
+                resetConnection(connection);
+                continue;
+            }
+            connection->isComplete = false;
+            connection->isBusy = false;
+            connection->lastActivity = millis();
+            _messageCount++;
+        }
+
+        if (connection->queueSize > 0) {
+            /* Send the next queued request for this host. */
+            PendingRequest pending = connection->queue[connection->queueHead];
+            connection->queueHead = (connection->queueHead + 1) % MAX_PENDING_REQUESTS;
+            connection->queueSize--;
+            if (!dispatchRequest(connection, pending)) {
+                Serial.println("Client dropped a queued request.");
+            }
+        } else if (millis() - connection->lastActivity > KEEPALIVE_TIMEOUT) {
+            /* Drop connections nobody has used in a while. */
+            closeConnection(connection);
+        }
     }
 }
 
+void DemobotClient::closeConnections() {
+    for (int i = 0; i < MAX_CONNECTIONS; i++) {
+        closeConnection(&_connections[i]);
+    }
+}
+
+unsigned long DemobotClient::getMessageCount() const {
+    return _messageCount;
+}
+
+unsigned long DemobotClient::getHandshakeCount() const {
+    return _handshakeCount;
+}
+
 DemobotClient::~DemobotClient() {
-    delete _request;
-}
\ No newline at end of file
+    closeConnections();
+
+    /* Wait for aborted requests to be reported before freeing them. */
+    unsigned long start = millis();
+    for (int i = 0; i < MAX_CONNECTIONS; i++) {
+        Connection *connection = &_connections[i];
+        while (connection->isClosing && !connection->isComplete &&
+               millis() - start < KEEPALIVE_TIMEOUT) {
+            delay(PING_POLL_WAIT);
+        }
+
+        /* Leaking a request that never reported back is safer than freeing
+         * it under the AsyncTCP task. */
+        if (connection->isClosing && !connection->isComplete) {
+            connection->request = nullptr;
+        }
+        resetConnection(connection);
+    }
+}
+
+/** Private methods. */
+
+String DemobotClient::getHost(const String url) const {
+    if (!url.startsWith("http://")) return String("");
+    int start = 7;
+    int end = url.indexOf('/', start);
+    if (end < 0) end = url.indexOf('?', start);
+    if (end < 0) end = url.length();
+    return url.substring(start, end);
+}
+
+DemobotClient::Connection *DemobotClient::getConnection(const String host) {
+    Connection *freeSlot = nullptr;
+    Connection *oldestIdle = nullptr;
+
+    for (int i = 0; i < MAX_CONNECTIONS; i++) {
+        Connection *connection = &_connections[i];
+
+        /* 1. reuse the connection already bound to this host. */
+        if (connection->request != nullptr && connection->host.equals(host)) {
+            return connection;
+        }
+
+        /* 2. otherwise remember a free slot or the least recently used idle
+         * connection we could take over. */
+        if (connection->request == nullptr) {
+            if (freeSlot == nullptr) freeSlot = connection;
+        } else if (!connection->isBusy && connection->queueSize == 0) {
+            /* Closing connections are busy, so they're never picked here. */
+            if (oldestIdle == nullptr ||
+                connection->lastActivity < oldestIdle->lastActivity) {
+                oldestIdle = connection;
+            }
+        }
+    }
+
+    /* 2b. if the pool is full, evict the least recently used connection. */
+    if (freeSlot == nullptr) {
+        if (oldestIdle == nullptr) return nullptr;
+        closeConnection(oldestIdle);
+        freeSlot = oldestIdle;
+    }
+
+    freeSlot->request = new asyncHTTPrequest();
+    freeSlot->host = host;
+    freeSlot->lastActivity = millis();
+    return freeSlot;
+}
+
+bool DemobotClient::submitRequest(
+    const String method,
+    const String url,
+    const String data,
+    httpRequestCallbackPtr_t *handler) {
+    String host = getHost(url);
+    if (host.length() == 0) {
+        Serial.println("Client only supports http:// URLs.");
+        return false;
+    }
+
+    Connection *connection = getConnection(host);
+    if (connection == nullptr) {
+        Serial.println("Client connection pool is full.");
+        return false;
+    }
+
+    /* Send immediately if the connection is free and nothing is ahead of us. */
+    if (!connection->isBusy && connection->queueSize == 0) {
+        return dispatchRequest(connection, PendingRequest{method, url, data, handler});
+    }
+
+    /* Otherwise wait behind the request in flight. */
+    if (connection->queueSize == MAX_PENDING_REQUESTS) {
+        Serial.println("Client request queue is full.");
+        return false;
+    }
+    int tail = (connection->queueHead + connection->queueSize) % MAX_PENDING_REQUESTS;
+    connection->queue[tail] = PendingRequest{method, url, data, handler};
+    connection->queueSize++;
+    return true;
+}
+
+bool DemobotClient::dispatchRequest(Connection *connection, const PendingRequest &pending) {
+    connection->handler = pending.handler;
+    connection->isBusy = true;
+    connection->isComplete = false;
+    connection->lastActivity = millis();
+
+    /* Set the response handler and send the request. */
+    connection->request->onReadyStateChange(
+        [this, connection](void *optParm, asyncHTTPrequest *request, int readyState) {
+            onReadyStateChange(connection, optParm, request, readyState);
+        }
+    );
+
+    if (_timeout > 0) connection->request->setTimeout(_timeout);
+
+    /* Callbacks raised from inside open() and send() are on this task, which
+     * lets onReadyStateChange() tell a reused connection from a new one. */
+    connection->openingTask = xTaskGetCurrentTaskHandle();
+    bool isOpen = connection->request->open(pending.method.c_str(), pending.url.c_str());
+    if (isOpen) {
+        connection->request->setReqHeader("Connection", "keep-alive");
+        if (pending.method.equals("POST")) {
+            connection->request->setReqHeader("Content-Type", "application/x-www-form-urlencoded");
+            connection->request->setReqHeader("Content-Length", pending.data.length());
+            connection->request->send(pending.data);
+        } else {
+            connection->request->send();
+        }
+    }
+    connection->openingTask = nullptr;
+
+    /* A failed connect already completed the request and told the handler;
+     * anything else failed before the handler could hear about it. */
+    if (!isOpen && !connection->isComplete) {
+        connection->isBusy = false;
+        return false;
+    }
+    return true;
+}
+
+void DemobotClient::onReadyStateChange(
+    Connection *connection,
+    void *optParm,
+    asyncHTTPrequest *request,
+    int readyState) {
+    /* New connections open from the AsyncTCP connect callback, while reused
+     * ones open synchronously from within dispatchRequest(). */
+    if (readyState == 1 && connection->openingTask != xTaskGetCurrentTaskHandle()) {
+        _handshakeCount++;
+    }
+
+    if (readyState == 4) connection->responseCode = request->responseHTTPcode();
+
+    /* An aborted request's handler was dropped with it. */
+    httpRequestCallbackPtr_t *handler = connection->handler;
+    if (handler != nullptr && !connection->isClosing) {
+        handler(optParm, request, readyState);
+    }
+
+    /* Hand the connection back last; the loop task may reuse or delete it as
+     * soon as this is set. Queued requests are sent from handleConnections()
+     * rather than here, since reopening the request from inside its own
+     * callback is unsafe. */
+    if (readyState == 4) connection->isComplete = true;
+}
+
+void DemobotClient::closeConnection(Connection *connection) {
+    if (connection->request == nullptr || connection->isClosing) return;
+
+    /* 1. a request in flight still has events on their way from the AsyncTCP
+     * task. Abort it, and keep the request around until the abort completes
+     * it in onReadyStateChange(). Until then the slot stays busy, bound to no
+     * host, so it can't be reused. */
+    if (connection->isBusy && !connection->isComplete) {
+        connection->isClosing = true;
+        connection->handler = nullptr;
+        connection->host = "";
+        connection->queueHead = 0;
+        connection->queueSize = 0;
+        connection->request->abort();
+        return;
+    }
+
+    /* 2. otherwise the request has completed and the socket is idle. Deleting
+     * the request closes the socket on this task and drops any of its events
+     * still queued, so nothing is reported into it afterwards. */
+    resetConnection(connection);
+}
+
+void DemobotClient::resetConnection(Connection *connection) {
+    delete connection->request;
+    connection->request = nullptr;
+    connection->host = "";
+    connection->handler = nullptr;
+    connection->isBusy = false;
+    connection->isComplete = false;
+    connection->isClosing = false;
+    connection->queueHead = 0;
+    connection->queueSize = 0;
+}
@@ -1,7 +1,7 @@
 /**
  * File: DemobotClient.h
  * Author: Matthew Yu
- * Last Modified: 03/16/21
+ * Last Modified: 10/18/26
  * Project: Demobots General
  * Organization: UT IEEE RAS
  * Description: Implements definitions for the DemobotClient class, which
@@ -12,13 +12,25 @@
 #include <asyncHTTPrequest.h>
 
 
+#define MAX_CONNECTIONS 4           /** Max simultaneous keep-alive connections. */
+#define MAX_PENDING_REQUESTS 4      /** Max queued requests per connection. */
+#define KEEPALIVE_TIMEOUT 10000     /** 10 s. */
+#define PING_POLL_WAIT 10           /** 10 ms. */
+
 typedef void (httpRequestCallbackPtr_t)(
     void *optParm, asyncHTTPrequest *request, int readyState);
 
 class DemobotClient {
     /**
      * The DemobotClient class allows the Demobot to send HTTP requests to
-     * DemobotServers.
+     * DemobotServers. Requests are sent over a small pool of connections, one
+     * per host, that ask the server to keep the socket open between messages.
+     * Whether the socket is actually reused depends on the server closing it
+     * or not; getHandshakeCount() shows how many connects really happened.
+     * Requests issued while a connection is busy are queued and sent in order
+     * once the previous response arrives. This is serial reuse, not HTTP
+     * pipelining; neither asyncHTTPrequest nor ESPAsyncWebServer support more
+     * than one request in flight per connection.
      */
     public:
         /** Creates a new DemobotClient. */
@@ -32,7 +44,8 @@ class DemobotClient {
          *                http://192.168.2.1:80)
          * @return Response code after sending a GET request to the server root
          *         endpoint ('/').
-         * @note This is a blocking call.
+         * @note This is a blocking call. Waits for any requests in flight to
+         *       the same host to finish first.
          */
         int pingServer(const String url);
 
@@ -46,8 +59,13 @@ class DemobotClient {
          * @param[in] argSize Number of key-value entries to go through.
          * @param[in] handler User defined function pointer that specifies what
          *                    happens when a server response is received.
+         * @return True if the request was sent or queued, in which case handler
+         *         is called once it completes or fails. False if the URL is
+         *         invalid, the connection pool or the host's request queue is
+         *         full, or the request could not be opened; handler is not
+         *         called.
          */
-        void sendGETRequest(
+        bool sendGETRequest(
             const String url,
             const String keys[],
             const String vals[],
@@ -64,17 +82,183 @@ class DemobotClient {
          * @param[in] argSize Number of key-value entries to go through.
          * @param[in] handler User defined function pointer that specifies what
          *                    happens when a server response is received.
+         * @return True if the request was sent or queued, in which case handler
+         *         is called once it completes or fails. False if the URL is
+         *         invalid, the connection pool or the host's request queue is
+         *         full, or the request could not be opened; handler is not
+         *         called.
          */
-        void sendPOSTRequest(
+        bool sendPOSTRequest(
             const String url,
             const String keys[],
             const String vals[],
             const int argSize,
             const httpRequestCallbackPtr_t handler);
 
+        /**
+         * Sets how long a request may go without hearing from the server
+         * before it fails. This includes connecting, so requests to absent
+         * hosts give up quickly. Applies to requests sent from now on.
+         *
+         * @param[in] seconds Timeout, in s. asyncHTTPrequest checks it about
+         *                    twice a second.
+         */
+        void setTimeout(const int seconds);
+
+        /**
+         * Frees connections whose request has completed, sends any queued
+         * requests, and closes connections that have been idle for longer
+         * than KEEPALIVE_TIMEOUT. Call this regularly, i.e. from loop().
+         * Connections only become free here, so a completed request is not
+         * counted by getMessageCount() until this is called.
+         */
+        void handleConnections();
+
+        /**
+         * Closes every connection and drops any queued requests. Useful for
+         * when we know a host has dropped and its connections are dead.
+         * Requests in flight are aborted without calling their handler, and
+         * their slot is only freed by handleConnections() once the abort has
+         * gone through.
+         */
+        void closeConnections();
+
+        /**
+         * Returns the number of requests that have completed, successfully or
+         * not.
+         *
+         * @return Number of completed requests.
+         */
+        unsigned long getMessageCount() const;
+
+        /**
+         * Returns the number of TCP connections opened so far. Counted when
+         * asyncHTTPrequest reports a connection opening from the AsyncTCP
+         * task, which only happens on a new connect; reusing an open
+         * connection reports it from within our own call to open it.
+         *
+         * @return Number of TCP handshakes performed.
+         */
+        unsigned long getHandshakeCount() const;
+
         ~DemobotClient();
 
     private:
-        /** Request object. */
-        asyncHTTPrequest *_request;
+        /** A request waiting for its connection to become free. */
+        struct PendingRequest {
+            String method;
+            String url;
+            String data;
+            httpRequestCallbackPtr_t *handler;
+        };
+
+        /** A keep-alive connection to a single host. */
+        struct Connection {
+            /** Request object. Owns the underlying TCP connection. */
+            asyncHTTPrequest *request;
+
+            /** host:port this connection is bound to. Empty if unused. */
+            String host;
+
+            /** Handler of the request in flight, if any. */
+            httpRequestCallbackPtr_t *handler;
+
+            /** Whether a request is in flight. Only changed on the loop task. */
+            bool isBusy;
+
+            /**
+             * Set from the AsyncTCP task once the request in flight has
+             * completed. handleConnections() hands the connection back to
+             * the loop task by clearing this and isBusy.
+             */
+            volatile bool isComplete;
+
+            /**
+             * Set when the request was aborted in flight. The AsyncTCP task
+             * reports the abort later, into the request, so the slot keeps
+             * the request alive until handleConnections() sees isComplete.
+             */
+            volatile bool isClosing;
+
+            /** Task currently opening the request, if any. */
+            volatile TaskHandle_t openingTask;
+
+            /** Response code of the last completed request. */
+            int responseCode;
+
+            /** Time, in ms, the connection was last used. */
+            unsigned long lastActivity;
+
+            /** FIFO ring buffer of requests waiting on this connection. */
+            PendingRequest queue[MAX_PENDING_REQUESTS];
+            int queueHead;
+            int queueSize;
+        };
+
+        /**
+         * Extracts the host and port from a URL.
+         *
+         * @param[in] url URL of the form http://192.168.2.1:80/hi.
+         * @return The host and port. (i.e. 192.168.2.1:80) Empty if the URL
+         *         is not an http:// URL.
+         */
+        String getHost(const String url) const;
+
+        /**
+         * Finds the connection bound to a host. If there is none, binds a free
+         * slot to it, evicting the least recently used idle connection if the
+         * pool is full.
+         *
+         * @param[in] host The host and port to connect to.
+         * @return The connection, or nullptr if every connection is busy.
+         */
+        Connection *getConnection(const String host);
+
+        /**
+         * Sends a request over the connection if it is free, otherwise queues
+         * it.
+         *
+         * @return True if the request was sent or queued, false otherwise.
+         */
+        bool submitRequest(
+            const String method,
+            const String url,
+            const String data,
+            httpRequestCallbackPtr_t *handler);
+
+        /**
+         * Sends a request over a free connection.
+         *
+         * @return False if the request could not be opened and its handler
+         *         was not called, true otherwise.
+         */
+        bool dispatchRequest(Connection *connection, const PendingRequest &pending);
+
+        /** Called on every ready state change of a connection's request. */
+        void onReadyStateChange(
+            Connection *connection,
+            void *optParm,
+            asyncHTTPrequest *request,
+            int readyState);
+
+        /**
+         * Closes the connection and returns its slot to the pool. If a
+         * request is in flight, aborts it and marks the slot as closing
+         * instead.
+         */
+        void closeConnection(Connection *connection);
+
+        /** Frees a connection's request and resets its slot. */
+        void resetConnection(Connection *connection);
+
+    private:
+        /** Connection pool. */
+        Connection _connections[MAX_CONNECTIONS];
+
+        /** Request timeout, in s. 0 to use asyncHTTPrequest's default. */
+        int _timeout;
+
+        /** Statistics. */
+        unsigned long _messageCount;
+        volatile unsigned long _handshakeCount;
 };
\ No newline at end of file
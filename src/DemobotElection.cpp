@@ -0,0 +1,328 @@
+/**
+ * File: DemobotElection.cpp
+ * Author: agent
+ * Last Modified: 10/18/26
+ * Project: Demobots General
+ * Organization: UT IEEE RAS
+ * Description: Implements definitions for the DemobotElection class, which
+ * detects when the host robot drops and decides which robot takes over.
+ */
+#include "DemobotElection.h"
+
+
+/** Public methods. */
+
+DemobotElection::DemobotElection(
+    const uint8_t self,
+    const uint8_t priority[],
+    const int numNodes,
+    const Role role,
+    const uint32_t now) {
+    _self = self;
+
+    /* Nodes left out of the priority list can never be elected. */
+    _numNodes = 0;
+    for (int i = 0; i < MAX_NODES; i++) {
+        _rank[i] = NO_NODE;
+        _lastHeartbeat[i] = now;
+    }
+    for (int i = 0; i < numNodes && i < MAX_NODES; i++) {
+        if (priority[i] >= MAX_NODES) continue;
+        _rank[priority[i]] = _numNodes;
+        _priority[_numNodes++] = priority[i];
+    }
+
+    _role = role;
+    _state = (role == HOST) ? CONNECTED : AWAITING;
+    _host = (role == HOST) ? self : NO_NODE;
+    _members = 1 << self;
+    _isConfirmed = false;
+    _isSteppingDown = false;
+    _lastResponder = NO_NODE;
+    _lastResponse = now;
+    _deadline = now;
+    _nextScan = (role == HOST) ? now + HOST_SCAN_INTERVAL : now;
+    _probeIndex = 0;
+    _failedNodes = 0;
+    _failedHosts = 0;
+    _isRecovering = false;
+    _failureTime = 0;
+    _recoveryTime = 0;
+}
+
+void DemobotElection::onHeartbeat(
+    const uint8_t node,
+    const uint8_t nodeHost,
+    const uint32_t now) {
+    if (_role != HOST || node >= MAX_NODES) return;
+
+    /* The member was recently talking to a better host that we didn't see
+     * fail; make way for it. */
+    if (nodeHost < MAX_NODES && nodeHost != _self &&
+        _rank[nodeHost] < _rank[_self] && !(_failedHosts & (1 << nodeHost))) {
+        stepDown(nodeHost, now);
+        return;
+    }
+
+    _lastHeartbeat[node] = now;
+    _members |= 1 << node;
+}
+
+void DemobotElection::onHostResponse(
+    const uint8_t host,
+    const uint16_t members,
+    const uint32_t now) {
+    if (host >= MAX_NODES) return;
+
+    if (_role == HOST) {
+        if (host != _self && _rank[host] < _rank[_self]) stepDown(host, now);
+        return;
+    }
+
+    if (_isRecovering) {
+        _recoveryTime = now - _failureTime;
+        _isRecovering = false;
+    }
+
+    /* Adopt the host's view so every member elects from the same list. */
+    _host = host;
+    _members = members | (1 << _self) | (1 << host);
+    _lastResponder = host;
+    _lastResponse = now;
+    _isConfirmed = true;
+    _failedNodes = 0;
+    _probeIndex = 0;
+    _state = CONNECTED;
+}
+
+DemobotElection::Action DemobotElection::update(const uint32_t now, const bool isLinkUp) {
+    if (_isSteppingDown) {
+        _isSteppingDown = false;
+        return JOIN_HOST;
+    }
+
+    if (_role == HOST) {
+        /* Drop members that have stopped sending heartbeats. */
+        for (int i = 0; i < MAX_NODES; i++) {
+            if (i != _self && isAfter(now, _lastHeartbeat[i] + FAILURE_TIMEOUT)) {
+                _members &= ~(1 << i);
+            }
+        }
+
+        /* Look for another host that members on its access point can't
+         * tell us about. */
+        if (isAfter(now, _nextScan)) {
+            _nextScan = now + HOST_SCAN_INTERVAL;
+            return SCAN_NETWORK;
+        }
+        return NONE;
+    }
+
+    /* A scan can tell us who is hosting, which saves probing for it. */
+    bool isScanDue = _host == NO_NODE && isAfter(now, _nextScan);
+
+    /* Without ever hearing from a host, we can't know that no one else is
+     * hosting, so never take over. */
+    if (!_isConfirmed) {
+        if (!isScanDue) return NONE;
+        _nextScan = now + HOST_SCAN_INTERVAL;
+        return SCAN_NETWORK;
+    }
+
+    switch (_state) {
+        case CONNECTED:
+            /* A dropped link alone doesn't mean the host failed; check
+             * whether its network is still there instead of timing out. */
+            if (!isLinkUp) {
+                _state = CHECKING;
+                return SCAN_NETWORK;
+            }
+            if (isAfter(now, _lastResponse + FAILURE_TIMEOUT)) return startElection(now);
+            return NONE;
+        case ELECTING:
+            if (isAfter(_failureTime + getTakeoverTime(_self), now)) return NONE;
+            _state = TAKING_OVER;
+            return SCAN_NETWORK;
+        case AWAITING:
+            /* If we're on the network but don't know who hosts it, someone
+             * does; keep probing rather than electing without a failed host
+             * to rule out. */
+            if (_host == NO_NODE && isLinkUp) _deadline = now + TAKEOVER_TIMEOUT;
+            if (isAfter(now, _deadline)) return startElection(now);
+            if (!isScanDue) return NONE;
+            _nextScan = now + HOST_SCAN_INTERVAL;
+            return SCAN_NETWORK;
+        default:
+            /* Waiting on a scan. */
+            return NONE;
+    }
+}
+
+DemobotElection::Action DemobotElection::onNetworkScan(
+    const bool isNetworkVisible,
+    const uint16_t hosts,
+    const uint32_t now) {
+    uint8_t host = getBestNode(hosts);
+
+    if (_role == HOST) {
+        /* Two hosts; the lower priority one makes way. */
+        if (host != NO_NODE && _rank[host] < _rank[_self]) {
+            stepDown(host, now);
+            _isSteppingDown = false;
+            return JOIN_HOST;
+        }
+        return NONE;
+    }
+
+    if (_state == CHECKING) {
+        /* 1a. our link dropped but the host is still up; rejoin it. */
+        if (isNetworkVisible || host != NO_NODE) {
+            if (host != NO_NODE) _host = host;
+            _state = AWAITING;
+            _deadline = now + TAKEOVER_TIMEOUT;
+            return JOIN_HOST;
+        }
+
+        /* 1b. the host's network is gone. */
+        return startElection(now);
+    }
+
+    if (_state == TAKING_OVER) {
+        /* 2a. someone with a different view of the members took over first.
+         * If the scan can't tell us who, find out by probing. */
+        if (isNetworkVisible || host != NO_NODE) {
+            _host = host;
+            _probeIndex = 0;
+            _state = AWAITING;
+            _deadline = now + TAKEOVER_TIMEOUT;
+            return JOIN_HOST;
+        }
+
+        /* 2b. nobody else is hosting; take over. */
+        _role = HOST;
+        _state = CONNECTED;
+        _host = _self;
+        _members = 1 << _self;
+        _lastResponder = NO_NODE;
+        _failedNodes = 0;
+        _nextScan = now + HOST_SCAN_INTERVAL;
+        _recoveryTime = now - _failureTime;
+        _isRecovering = false;
+
+        /* Give the other members time to rejoin before dropping them. */
+        for (int i = 0; i < MAX_NODES; i++) _lastHeartbeat[i] = now;
+        return BECOME_HOST;
+    }
+
+    /* 3. we were waiting for a host; heartbeat it directly. */
+    if (_state == AWAITING && _host == NO_NODE) _host = host;
+    return NONE;
+}
+
+uint8_t DemobotElection::getHeartbeatTarget() const {
+    if (_role == HOST) return NO_NODE;
+    return _host;
+}
+
+uint8_t DemobotElection::getProbeTarget() {
+    if (_role == HOST || _state == CONNECTED) return NO_NODE;
+    for (int i = 0; i < _numNodes; i++) {
+        uint8_t node = _priority[_probeIndex];
+        _probeIndex = (_probeIndex + 1) % _numNodes;
+        if (node != _self && node != _host && !(_failedNodes & (1 << node))) return node;
+    }
+    return NO_NODE;
+}
+
+uint8_t DemobotElection::getConfirmedHost(const uint32_t now) const {
+    if (_role != MEMBER || isAfter(now, _lastResponse + TAKEOVER_TIMEOUT)) return NO_NODE;
+    return _lastResponder;
+}
+
+DemobotElection::Role DemobotElection::getRole() const {
+    return _role;
+}
+
+uint8_t DemobotElection::getHost() const {
+    return _host;
+}
+
+uint16_t DemobotElection::getMembers() const {
+    return _members;
+}
+
+uint32_t DemobotElection::getRecoveryTime() const {
+    return _recoveryTime;
+}
+
+/** Private methods. */
+
+DemobotElection::Action DemobotElection::startElection(const uint32_t now) {
+    /* 1. the host failed; remove it from the list of alive nodes. Times are
+     * counted from our last contact with it, which the other members share
+     * to within a heartbeat. */
+    if (!_isRecovering) {
+        _isRecovering = true;
+        _failureTime = _lastResponse;
+    }
+    if (_host != NO_NODE) {
+        _members &= ~(1 << _host);
+        _failedNodes |= 1 << _host;
+        _failedHosts |= 1 << _host;
+    }
+
+    /* 2. elect the highest priority survivor. If it's us, wait for our slot
+     * before checking that nobody else took over. */
+    uint8_t host = electHost();
+    if (host == _self || host == NO_NODE) {
+        _host = NO_NODE;
+        _state = ELECTING;
+        return update(now, false);
+    }
+
+    /* 2b. someone else won; wait for them to take over. */
+    uint32_t deadline = _failureTime + getTakeoverTime(host) + TAKEOVER_TIMEOUT;
+    _host = host;
+    _state = AWAITING;
+    _deadline = isAfter(deadline, now + TAKEOVER_TIMEOUT) ? deadline : now + TAKEOVER_TIMEOUT;
+    return JOIN_HOST;
+}
+
+void DemobotElection::stepDown(const uint8_t host, const uint32_t now) {
+    _role = MEMBER;
+    _state = AWAITING;
+    _host = host;
+    _members = (1 << _self) | (1 << host);
+    _isConfirmed = true;
+    _isSteppingDown = true;
+    _lastResponder = NO_NODE;
+    _deadline = now + TAKEOVER_TIMEOUT;
+}
+
+uint8_t DemobotElection::electHost() const {
+    for (int i = 0; i < _numNodes; i++) {
+        if (_members & (1 << _priority[i])) return _priority[i];
+    }
+    return NO_NODE;
+}
+
+uint8_t DemobotElection::getBestNode(const uint16_t nodes) const {
+    for (int i = 0; i < _numNodes; i++) {
+        if (_priority[i] != _self && (nodes & (1 << _priority[i]))) return _priority[i];
+    }
+    return NO_NODE;
+}
+
+uint32_t DemobotElection::getTakeoverTime(const uint8_t node) const {
+    /* One slot for every higher priority node that hasn't already failed. */
+    int rank = (node < MAX_NODES && _rank[node] != NO_NODE) ? _rank[node] : _numNodes;
+    uint32_t slots = 0;
+    for (int i = 0; i < rank; i++) {
+        if (!(_failedNodes & (1 << _priority[i]))) slots++;
+    }
+    return FAILURE_TIMEOUT + slots * TAKEOVER_STAGGER;
+}
+
+bool DemobotElection::isAfter(const uint32_t a, const uint32_t b) {
+    return (int32_t)(a - b) > 0;
+}
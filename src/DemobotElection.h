@@ -0,0 +1,288 @@
+/**
+ * File: DemobotElection.h
+ * Author: agent
+ * Last Modified: 10/18/26
+ * Project: Demobots General
+ * Organization: UT IEEE RAS
+ * Description: Implements definitions for the DemobotElection class, which
+ * detects when the host robot drops and decides which robot takes over.
+ */
+#pragma once
+
+#include <stdint.h>
+
+
+#define MAX_NODES 16
+#define NO_NODE 0xFF
+#define HEARTBEAT_INTERVAL 250      /** 250 ms. */
+#define FAILURE_TIMEOUT 1000        /** 1 s. */
+#define TAKEOVER_STAGGER 2000       /** 2 s. */
+#define TAKEOVER_TIMEOUT 5000       /** 5 s. */
+#define HOST_SCAN_INTERVAL 2000     /** 2 s. */
+
+class DemobotElection {
+    /**
+     * The DemobotElection class is a heartbeat based failure detector and
+     * election for the robot hosting the network.
+     *
+     * Members heartbeat the host, and the host replies with every node it has
+     * heard from recently. A member decides the host failed when the host
+     * stops replying for FAILURE_TIMEOUT, or when its link drops and a scan
+     * shows the network is gone. It then removes the host from the host's
+     * last list of nodes and picks the remaining node with the highest
+     * priority.
+     *
+     * Members can hold different lists if the host's membership changed just
+     * before it failed, so a node elected from its own list does not take
+     * over right away. It waits a slot based on its priority, counted from
+     * its last contact with the failed host, then scans for the network and
+     * only becomes host if nobody else has brought it up. Higher priority
+     * nodes go first, so the rest find their access point and join it.
+     *
+     * Nodes that have never heard from a host never elect themselves. Two
+     * hosts can still end up running, i.e. when two robots boot at the same
+     * time and neither finds a network. Members of one access point can't
+     * reach the other, so hosts scan for each other every HOST_SCAN_INTERVAL
+     * and the lower priority one steps down and rejoins. A host also steps
+     * down if a member vouches for a higher priority host in its heartbeat,
+     * since members vouch for the last host that responded to them. A host
+     * ignores vouches for hosts it saw fail.
+     *
+     * This class does no networking and takes the current time as an
+     * argument, so it can be run with simulated nodes off the robot. It is
+     * not thread safe.
+     */
+    public:
+        /** Whether this node is the host or a member of the network. */
+        enum Role { HOST, MEMBER };
+
+        /** What the caller should do next. */
+        enum Action {
+            NONE,
+
+            /** Scan for the network and report back with onNetworkScan(). */
+            SCAN_NETWORK,
+
+            /** Start the access point. */
+            BECOME_HOST,
+
+            /** Stop any access point and rejoin the network as a station. */
+            JOIN_HOST
+        };
+
+        /**
+         * Creates a new DemobotElection.
+         *
+         * @param[in] self ID of this node. Must be less than MAX_NODES.
+         * @param[in] priority Array of node IDs, highest priority first. Nodes
+         *                     not in the array are never elected.
+         * @param[in] numNodes Number of entries in priority.
+         * @param[in] role Whether this node starts as the host or a member.
+         * @param[in] now Current time, in ms.
+         */
+        DemobotElection(
+            const uint8_t self,
+            const uint8_t priority[],
+            const int numNodes,
+            const Role role,
+            const uint32_t now);
+
+        /**
+         * Records a heartbeat from a member. Used by the host.
+         *
+         * @param[in] node ID of the member.
+         * @param[in] nodeHost The member's getConfirmedHost(). If this is a
+         *                     higher priority host, we step down.
+         * @param[in] now Current time, in ms.
+         */
+        void onHeartbeat(const uint8_t node, const uint8_t nodeHost, const uint32_t now);
+
+        /**
+         * Records a heartbeat response from a host. If we are a host and it
+         * has a higher priority, we step down.
+         *
+         * @param[in] host ID of the host that responded.
+         * @param[in] members Bitmask of the nodes the host considers alive.
+         * @param[in] now Current time, in ms.
+         */
+        void onHostResponse(const uint8_t host, const uint16_t members, const uint32_t now);
+
+        /**
+         * Checks for failed nodes and moves the election along. The host asks
+         * for a scan every HOST_SCAN_INTERVAL to look for other hosts, and so
+         * does a member that doesn't know the host, to find it.
+         *
+         * @param[in] now Current time, in ms.
+         * @param[in] isLinkUp Whether we are connected to the network as a
+         *                     station. Ignored by the host.
+         * @return The action the caller should take.
+         */
+        Action update(const uint32_t now, const bool isLinkUp);
+
+        /**
+         * Reports the result of a scan requested with SCAN_NETWORK. A host
+         * steps down if it sees a higher priority host.
+         *
+         * @param[in] isNetworkVisible Whether the network is still up.
+         * @param[in] hosts Bitmask of the nodes whose access point was seen.
+         *                  Access points that aren't a node's only count
+         *                  towards isNetworkVisible.
+         * @param[in] now Current time, in ms.
+         * @return The action the caller should take.
+         */
+        Action onNetworkScan(
+            const bool isNetworkVisible,
+            const uint16_t hosts,
+            const uint32_t now);
+
+        /**
+         * Returns the node to send the next heartbeat to: the current or
+         * elected host.
+         *
+         * @return Node ID, or NO_NODE if we should not send heartbeats.
+         */
+        uint8_t getHeartbeatTarget() const;
+
+        /**
+         * Returns the next node to probe with a heartbeat while we aren't
+         * connected to a host. Cycles through every node other than the
+         * expected host and nodes seen failing, in priority order starting
+         * from the top each time we lose the host. Probes may be
+         * sent alongside heartbeats, so a probe to an absent node doesn't
+         * hold up the heartbeats.
+         *
+         * @return Node ID, or NO_NODE if we should not probe.
+         */
+        uint8_t getProbeTarget();
+
+        /**
+         * Returns the host that last responded to us, if it did so within
+         * TAKEOVER_TIMEOUT. Sent with heartbeats so that a lower priority host
+         * can step down.
+         *
+         * @param[in] now Current time, in ms.
+         * @return Host ID, or NO_NODE.
+         */
+        uint8_t getConfirmedHost(const uint32_t now) const;
+
+        /**
+         * Returns whether this node is the host or a member.
+         *
+         * @return Role of this node.
+         */
+        Role getRole() const;
+
+        /**
+         * Returns the ID of the current or elected host.
+         *
+         * @return Host ID. NO_NODE if a member does not know the host.
+         */
+        uint8_t getHost() const;
+
+        /**
+         * Returns the nodes believed to be alive, including this one.
+         *
+         * @return Bitmask where bit i is set if node i is alive.
+         */
+        uint16_t getMembers() const;
+
+        /**
+         * Returns how long the last failover took, measured from the last
+         * contact with the failed host to becoming host or first hearing from
+         * the new host.
+         *
+         * @return Recovery time, in ms. 0 if there has been no failover.
+         */
+        uint32_t getRecoveryTime() const;
+
+    private:
+        /** Where a member is in detecting and recovering from a failure. */
+        enum State {
+            /** Heartbeating the host. */
+            CONNECTED,
+
+            /** Link dropped; waiting on a scan to see if the host is gone. */
+            CHECKING,
+
+            /** Elected ourselves; waiting for our takeover slot. */
+            ELECTING,
+
+            /** Waiting on a scan to see if someone else took over. */
+            TAKING_OVER,
+
+            /** Waiting to hear from a host. */
+            AWAITING
+        };
+
+        /**
+         * Drops the failed host and elects a new one.
+         *
+         * @return The action the caller should take.
+         */
+        Action startElection(const uint32_t now);
+
+        /** Switches to member and waits for a host. */
+        void stepDown(const uint8_t host, const uint32_t now);
+
+        /** Picks the alive node with the highest priority. */
+        uint8_t electHost() const;
+
+        /** Picks the node in a bitmask with the highest priority, other than us. */
+        uint8_t getBestNode(const uint16_t nodes) const;
+
+        /**
+         * Returns how long after the failed host's last contact a node may
+         * take over. Nodes that already failed this recovery don't count.
+         */
+        uint32_t getTakeoverTime(const uint8_t node) const;
+
+        /** Compares times, handling millis() wrapping. */
+        static bool isAfter(const uint32_t a, const uint32_t b);
+
+    private:
+        /** ID of this node. */
+        uint8_t _self;
+
+        /** Node IDs in priority order, and each node's rank in it. */
+        uint8_t _priority[MAX_NODES];
+        int _numNodes;
+        uint8_t _rank[MAX_NODES];
+
+        Role _role;
+        State _state;
+        uint8_t _host;
+        uint16_t _members;
+
+        /** Whether a host has ever responded to us. */
+        bool _isConfirmed;
+
+        /** Whether we stepped down and still need to tell the caller. */
+        bool _isSteppingDown;
+
+        /** Host: time each member last sent a heartbeat, in ms. */
+        uint32_t _lastHeartbeat[MAX_NODES];
+
+        /** Time of the next scan for hosts, in ms. */
+        uint32_t _nextScan;
+
+        /** Member: last host to respond, and when. */
+        uint8_t _lastResponder;
+        uint32_t _lastResponse;
+
+        /** Member: time we give up waiting on a host, in ms. */
+        uint32_t _deadline;
+
+        /** Member: index into _priority of the next node to probe. */
+        int _probeIndex;
+
+        /** Nodes that failed during the current recovery. */
+        uint16_t _failedNodes;
+
+        /** Hosts we have seen fail. Their vouches are ignored. */
+        uint16_t _failedHosts;
+
+        /** Failover timing. */
+        bool _isRecovering;
+        uint32_t _failureTime;
+        uint32_t _recoveryTime;
+};
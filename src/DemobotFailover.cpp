@@ -0,0 +1,214 @@
+/**
+ * File: DemobotFailover.cpp
+ * Author: agent
+ * Last Modified: 10/18/26
+ * Project: Demobots General
+ * Organization: UT IEEE RAS
+ * Description: Implements definitions for the DemobotFailover class, which
+ * lets the robots pick a new host when the robot hosting the network drops.
+ */
+#include "DemobotFailover.h"
+
+
+/** Robots in order of preference for hosting the network. */
+const uint8_t hostPriority[] = {
+    DemobotNetwork::MOTHERSHIP,
+    DemobotNetwork::DANCEBOT_1,
+    DemobotNetwork::DANCEBOT_2,
+    DemobotNetwork::DANCEBOT_3,
+    DemobotNetwork::DANCEBOT_4,
+    DemobotNetwork::DANCEBOT_5,
+    DemobotNetwork::POLARGRAPH,
+    DemobotNetwork::MARQUEE,
+    DemobotNetwork::TOWER_OF_POWER
+};
+
+DemobotFailover *DemobotFailover::_instance = nullptr;
+
+/** Public methods. */
+
+DemobotFailover::DemobotFailover(
+    const DemobotNetwork::DemobotID ID,
+    DemobotNetwork *network,
+    DemobotServer *server,
+    DemobotClient *client) {
+    _ID = ID;
+    _network = network;
+    _server = server;
+    _client = client;
+    _election = new DemobotElection(
+        ID,
+        hostPriority,
+        sizeof(hostPriority) / sizeof(hostPriority[0]),
+        network->isAccessPoint() ? DemobotElection::HOST : DemobotElection::MEMBER,
+        millis());
+    _lastHeartbeat = 0;
+    _lastProbe = 0;
+    _isHeartbeatPending = false;
+    _isProbePending = false;
+    _instance = this;
+
+    /* Don't let requests to absent robots hang for the library default. */
+    _client->setTimeout(HEARTBEAT_TIMEOUT);
+}
+
+bool DemobotFailover::addHeartbeatEndpoint() {
+    return _server->addPOSTEndpoint(String("/heartbeat"), onHeartbeat);
+}
+
+void DemobotFailover::handleFailover() {
+    /* Read the link outside the lock; WiFi calls can block. */
+    bool isLinkUp = _network->isNetworkConnected();
+
+    portENTER_CRITICAL(&_lock);
+    DemobotElection::Action action = _election->update(millis(), isLinkUp);
+    portEXIT_CRITICAL(&_lock);
+
+    if (action == DemobotElection::SCAN_NETWORK) {
+        uint16_t hosts;
+        bool isVisible = _network->scanNetwork(&hosts);
+        portENTER_CRITICAL(&_lock);
+        action = _election->onNetworkScan(isVisible, hosts, millis());
+        portEXIT_CRITICAL(&_lock);
+    }
+
+    /* Connections to the old host are dead; don't wait on them to time out. */
+    if (action == DemobotElection::BECOME_HOST || action == DemobotElection::JOIN_HOST) {
+        _client->closeConnections();
+        _isHeartbeatPending = false;
+        _isProbePending = false;
+    }
+
+    switch (action) {
+        case DemobotElection::BECOME_HOST:
+            Serial.println("Taking over the network.");
+            _network->hostNetwork();
+            _network->connectNetwork();
+            break;
+        case DemobotElection::JOIN_HOST:
+            Serial.println("Rejoining the network.");
+            _network->rejoinNetwork();
+            break;
+        default:
+            break;
+    }
+
+    /* Members heartbeat the host, and probe for it while they aren't
+     * connected. One of each is in flight at a time so that requests to a
+     * dead or unknown host can't fill up the client. Failure is detected by
+     * the lack of a response, so requests that hang don't hold up the
+     * election. */
+    if (!isLinkUp) return;
+    unsigned long now = millis();
+    bool isHeartbeatDue = !_isHeartbeatPending && (long)(now - _lastHeartbeat) >= HEARTBEAT_INTERVAL;
+    bool isProbeDue = !_isProbePending && (long)(now - _lastProbe) >= HEARTBEAT_INTERVAL;
+    if (!isHeartbeatDue && !isProbeDue) return;
+
+    portENTER_CRITICAL(&_lock);
+    uint8_t target = isHeartbeatDue ? _election->getHeartbeatTarget() : NO_NODE;
+    uint8_t probe = isProbeDue ? _election->getProbeTarget() : NO_NODE;
+    uint8_t host = _election->getConfirmedHost(now);
+    portEXIT_CRITICAL(&_lock);
+
+    if (target != NO_NODE) {
+        _lastHeartbeat = now;
+        _isHeartbeatPending = true;
+        if (!sendHeartbeat(target, host, onHeartbeatResponse)) _isHeartbeatPending = false;
+    }
+    if (probe != NO_NODE) {
+        _lastProbe = now;
+        _isProbePending = true;
+        if (!sendHeartbeat(probe, host, onProbeResponse)) _isProbePending = false;
+    }
+}
+
+bool DemobotFailover::isHost() const {
+    portENTER_CRITICAL(&_lock);
+    bool isHost = _election->getRole() == DemobotElection::HOST;
+    portEXIT_CRITICAL(&_lock);
+    return isHost;
+}
+
+unsigned long DemobotFailover::getRecoveryTime() const {
+    portENTER_CRITICAL(&_lock);
+    unsigned long recoveryTime = _election->getRecoveryTime();
+    portEXIT_CRITICAL(&_lock);
+    return recoveryTime;
+}
+
+DemobotFailover::~DemobotFailover() {
+    if (_instance == this) _instance = nullptr;
+    delete _election;
+}
+
+/** Private methods. */
+
+void DemobotFailover::onHeartbeat(AsyncWebServerRequest *request) {
+    if (_instance == nullptr || !request->hasParam("ID", true)) {
+        request->send(400, "text/plain", "Bad heartbeat.");
+        return;
+    }
+    uint8_t node = request->getParam("ID", true)->value().toInt();
+    uint8_t nodeHost = request->hasParam("HOST", true) ?
+        request->getParam("HOST", true)->value().toInt() : NO_NODE;
+
+    DemobotFailover *failover = _instance;
+    portENTER_CRITICAL(&failover->_lock);
+    failover->_election->onHeartbeat(node, nodeHost, millis());
+    bool isHost = failover->_election->getRole() == DemobotElection::HOST;
+    uint8_t host = failover->_election->getHost();
+    uint16_t members = failover->_election->getMembers();
+    portEXIT_CRITICAL(&failover->_lock);
+
+    /* Only the host answers, so members pointed at the wrong robot keep
+     * looking. This includes a host that just stepped down. */
+    if (!isHost) {
+        request->send(503, "text/plain", "Not host.");
+        return;
+    }
+
+    /* Respond with <host ID>,<members bitmask>. */
+    request->send(200, "text/plain", String(host) + "," + String(members));
+}
+
+void DemobotFailover::onHeartbeatResponse(
+    void *optParm, asyncHTTPrequest *request, int readyState) {
+    if (readyState != 4 || _instance == nullptr) return;
+    handleResponse(request);
+    _instance->_isHeartbeatPending = false;
+}
+
+void DemobotFailover::onProbeResponse(
+    void *optParm, asyncHTTPrequest *request, int readyState) {
+    if (readyState != 4 || _instance == nullptr) return;
+    handleResponse(request);
+    _instance->_isProbePending = false;
+}
+
+void DemobotFailover::handleResponse(asyncHTTPrequest *request) {
+    if (request->responseHTTPcode() != 200) return;
+
+    /* Parse <host ID>,<members bitmask>. */
+    String response = request->responseText();
+    int split = response.indexOf(',');
+    if (split < 0) return;
+    uint8_t host = response.substring(0, split).toInt();
+    uint16_t members = response.substring(split + 1).toInt();
+
+    DemobotFailover *failover = _instance;
+    portENTER_CRITICAL(&failover->_lock);
+    failover->_election->onHostResponse(host, members, millis());
+    portEXIT_CRITICAL(&failover->_lock);
+}
+
+bool DemobotFailover::sendHeartbeat(
+    const uint8_t target,
+    const uint8_t host,
+    const httpRequestCallbackPtr_t handler) {
+    IPAddress ip = DemobotNetwork::getIPAddress(static_cast<DemobotNetwork::DemobotID>(target));
+    String url = String("http://" + _network->IpAddress2String(ip) + ":" + _server->getPort() + "/heartbeat");
+
+    String keys[2] = {String("ID"), String("HOST")};
+    String vals[2] = {String(_ID), String(host)};
+    return _client->sendPOSTRequest(url, keys, vals, 2, handler);
+}
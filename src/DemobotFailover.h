@@ -0,0 +1,135 @@
+/**
+ * File: DemobotFailover.h
+ * Author: agent
+ * Last Modified: 10/18/26
+ * Project: Demobots General
+ * Organization: UT IEEE RAS
+ * Description: Implements definitions for the DemobotFailover class, which
+ * lets the robots pick a new host when the robot hosting the network drops.
+ */
+#pragma once
+
+#include "DemobotNetwork.h"
+#include "DemobotServer.h"
+#include "DemobotClient.h"
+#include "DemobotElection.h"
+
+
+#define HEARTBEAT_TIMEOUT 1         /** 1 s, the shortest asyncHTTPrequest allows. */
+
+class DemobotFailover {
+    /**
+     * The DemobotFailover class runs a DemobotElection over HTTP. Members POST
+     * heartbeats to the host's /heartbeat endpoint, and when the host stops
+     * answering, the elected survivor takes over the access point while the
+     * others rejoin it. Robots are prioritized in the order MOTHERSHIP,
+     * DANCEBOT_1 to DANCEBOT_5, POLARGRAPH, MARQUEE, TOWER_OF_POWER.
+     *
+     * While a member doesn't know the host, it also probes the other robots
+     * to find it. Heartbeats and probes are sent alongside each other, one
+     * of each at a time, and time out after HEARTBEAT_TIMEOUT, so probes to
+     * robots that are off don't hold up the heartbeats.
+     *
+     * Every robot should run a DemobotServer so that whichever one is elected
+     * can answer heartbeats. Only one DemobotFailover may exist per robot.
+     * The heartbeat callbacks run on the AsyncTCP task, so every use of the
+     * election is guarded by a lock.
+     */
+    public:
+        /**
+         * Creates a new DemobotFailover. The robot starts as the host if the
+         * network is configured for AP mode, and as a member otherwise.
+         *
+         * @param[in] ID Enum referencing this Demobot.
+         * @param[in] network Network this robot is connected to.
+         * @param[in] server Server this robot is running.
+         * @param[in] client Client used to send heartbeats. Its timeout is
+         *                   set to HEARTBEAT_TIMEOUT, so it shouldn't be
+         *                   shared with requests that need longer.
+         */
+        DemobotFailover(
+            const DemobotNetwork::DemobotID ID,
+            DemobotNetwork *network,
+            DemobotServer *server,
+            DemobotClient *client);
+
+        /**
+         * Adds the /heartbeat endpoint to the server. Call this before
+         * starting the server.
+         *
+         * @return True if the endpoint was set up. False otherwise.
+         */
+        bool addHeartbeatEndpoint();
+
+        /**
+         * Sends heartbeats, detects host failure, and takes over or rejoins
+         * the network when a new host is elected. Call this regularly, i.e.
+         * from loop().
+         */
+        void handleFailover();
+
+        /**
+         * Checks to see if this robot is the host.
+         *
+         * @return True if this robot hosts the network, false otherwise.
+         */
+        bool isHost() const;
+
+        /**
+         * Returns how long the last failover took.
+         *
+         * @return Recovery time, in ms. 0 if there has been no failover.
+         */
+        unsigned long getRecoveryTime() const;
+
+        ~DemobotFailover();
+
+    private:
+        /** Server callback for heartbeats from members. */
+        static void onHeartbeat(AsyncWebServerRequest *request);
+
+        /** Client callback for the host's response to our heartbeat. */
+        static void onHeartbeatResponse(
+            void *optParm, asyncHTTPrequest *request, int readyState);
+
+        /** Client callback for the response to a probe. */
+        static void onProbeResponse(
+            void *optParm, asyncHTTPrequest *request, int readyState);
+
+        /** Passes a heartbeat response from a host on to the election. */
+        static void handleResponse(asyncHTTPrequest *request);
+
+        /**
+         * Sends a heartbeat.
+         *
+         * @param[in] target ID of the robot to send it to.
+         * @param[in] host The host we vouch for.
+         * @param[in] handler Callback for the response.
+         * @return True if the heartbeat was sent, false otherwise.
+         */
+        bool sendHeartbeat(
+            const uint8_t target,
+            const uint8_t host,
+            const httpRequestCallbackPtr_t handler);
+
+    private:
+        /** The single instance, used by the static callbacks. */
+        static DemobotFailover *_instance;
+
+        DemobotNetwork::DemobotID _ID;
+        DemobotNetwork *_network;
+        DemobotServer *_server;
+        DemobotClient *_client;
+        DemobotElection *_election;
+
+        /** Guards _election, which the AsyncTCP task also uses. */
+        mutable portMUX_TYPE _lock = portMUX_INITIALIZER_UNLOCKED;
+
+        /** Time, in ms, we last sent a heartbeat and a probe. */
+        unsigned long _lastHeartbeat;
+        unsigned long _lastProbe;
+
+        /** Whether a heartbeat or probe is waiting on a response. */
+        volatile bool _isHeartbeatPending;
+        volatile bool _isProbePending;
+};
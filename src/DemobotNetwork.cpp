@@ -1,7 +1,7 @@
 /**
  * File: DemobotNetwork.cpp
  * Author: Matthew Yu
- * Last Modified: 03/16/21
+ * Last Modified: 10/18/26
  * Project: Demobots General
  * Organization: UT IEEE RAS
  * Description: Implements definitions for the DemobotNetwork class, which
@@ -9,6 +9,7 @@
  * some credentials.
  */
 #include "DemobotNetwork.h"
+#include <esp_wifi.h>
 
 
 /** Redirect any traffic with an unknown address to here. */
@@ -21,9 +22,15 @@ IPAddress subnet(255,255,0,0);
 IPAddress primaryDNS(8, 8, 8, 8);
 IPAddress secondaryDNS(8, 8, 4, 4);
 
+/** Locally administered prefix of every robot's access point BSSID. */
+const uint8_t bssidPrefix[5] = {0x02, 0x44, 0x45, 0x4D, 0x4F};
+
 /** Public methods. */
 
 DemobotNetwork::DemobotNetwork(const DemobotID ID) {
+    _SSID = nullptr;
+    _PASSWORD = nullptr;
+
     /* Generate possible network credentials. */
     credentialsLog = new Credential[numCredentials] {
         Credential{"Demobot", "Demobots1234"},
@@ -33,31 +40,41 @@ DemobotNetwork::DemobotNetwork(const DemobotID ID) {
     };
 
     /* Set server IP based on robot ID. */
+    _ID = ID;
+    _ipAddress = getIPAddress(ID);
+
+    /* Set credentials. */
+    reconfigureNetworks();
+}
+
+IPAddress DemobotNetwork::getIPAddress(const DemobotID ID) {
     switch(ID) {
+        case MOTHERSHIP:
+            return IPAddress(192,168,2,1);
         case DANCEBOT_1:
+            return IPAddress(192,168,2,11);
         case DANCEBOT_2:
+            return IPAddress(192,168,2,12);
         case DANCEBOT_3:
+            return IPAddress(192,168,2,13);
         case DANCEBOT_4:
+            return IPAddress(192,168,2,14);
         case DANCEBOT_5:
-        case MOTHERSHIP:
-            _ipAddress = IPAddress(192,168,2,1);
-            break;
+            return IPAddress(192,168,2,15);
         case POLARGRAPH:
-            _ipAddress = IPAddress(192,168,2,2);
-            break;
+            return IPAddress(192,168,2,2);
         case MARQUEE:
-            _ipAddress = IPAddress(192,168,2,3);
-            break;
+            return IPAddress(192,168,2,3);
         case TOWER_OF_POWER:
-            _ipAddress = IPAddress(192,168,2,4);
-            break;
+            return IPAddress(192,168,2,4);
         default:
-            _ipAddress = IPAddress(192,168,2,0);
-            break;
+            return IPAddress(192,168,2,0);
     }
+}
 
-    /* Set credentials. */
-    reconfigureNetworks();
+void DemobotNetwork::getBSSID(const DemobotID ID, uint8_t bssid[6]) {
+    memcpy(bssid, bssidPrefix, sizeof(bssidPrefix));
+    bssid[5] = ID;
 }
 
 void DemobotNetwork::reconfigureNetworks() {
@@ -74,6 +91,58 @@ void DemobotNetwork::reconfigureNetworks() {
     }
 }
 
+void DemobotNetwork::hostNetwork() {
+    /* Keep the same network so the other robots can rejoin without a scan. */
+    if (_SSID == nullptr || _PASSWORD == nullptr) {
+        _SSID = const_cast<char*>(credentialsLog[0].SSID);
+        _PASSWORD = const_cast<char*>(credentialsLog[0].PASSWORD);
+    }
+    _mode = AP;
+    Serial.println("Network configured for AP mode.");
+}
+
+bool DemobotNetwork::rejoinNetwork() {
+    if (_SSID == nullptr || _PASSWORD == nullptr) return false;
+
+    _mode = STA;
+    if (!WiFi.config(_ipAddress, gateway, subnet, primaryDNS, secondaryDNS)) {
+        Serial.println("STA failed to configure.");
+    }
+    WiFi.softAPdisconnect(true);
+    WiFi.mode(WIFI_STA);
+    WiFi.begin(_SSID, _PASSWORD);
+    return true;
+}
+
+bool DemobotNetwork::scanNetwork(uint16_t *hosts) {
+    *hosts = 0;
+    if (_SSID == nullptr) return false;
+
+    /* Stop any reconnect attempts, which would make the scan fail. */
+    if (_mode == STA && WiFi.status() != WL_CONNECTED) WiFi.disconnect();
+
+    int networks = WiFi.scanNetworks(
+        false, false, false, SCAN_TIME_PER_CHANNEL, HOST_CHANNEL, _SSID);
+
+    /* If we can't tell, assume it's up rather than risk a second AP. */
+    if (networks < 0) return true;
+
+    bool isVisible = false;
+    for (int i = 0; i < networks; i++) {
+        if (!WiFi.SSID(i).equals(String(_SSID))) continue;
+        isVisible = true;
+
+        /* Access points that aren't a robot's still count as the network. */
+        uint8_t *bssid = WiFi.BSSID(i);
+        if (bssid != nullptr && memcmp(bssid, bssidPrefix, sizeof(bssidPrefix)) == 0 &&
+            bssid[5] <= TOWER_OF_POWER) {
+            *hosts |= 1 << bssid[5];
+        }
+    }
+    WiFi.scanDelete();
+    return isVisible;
+}
+
 bool DemobotNetwork::connectNetwork() {
     /* Don't attempt to connect without valid credentials. */
     if (_SSID == nullptr || _PASSWORD == nullptr) return false;
@@ -86,9 +155,15 @@ bool DemobotNetwork::connectNetwork() {
             Serial.println("AP failed to configure.");
         }
 
-        /* Set up our own access point. */
+        /* Set up our own access point, with a BSSID that tells the other
+         * robots who is hosting. */
         WiFi.mode(WIFI_AP);
-        if (!WiFi.softAP(_SSID, _PASSWORD)) {
+        uint8_t bssid[6];
+        getBSSID(_ID, bssid);
+        if (esp_wifi_set_mac(WIFI_IF_AP, bssid) != ESP_OK) {
+            Serial.println("AP failed to set BSSID.");
+        }
+        if (!WiFi.softAP(_SSID, _PASSWORD, HOST_CHANNEL)) {
             Serial.println("AP failed to start.");
         }
 
@@ -151,6 +226,10 @@ bool DemobotNetwork::isNetworkConnected() const {
     return WiFi.status() == WL_CONNECTED;
 }
 
+bool DemobotNetwork::isAccessPoint() const {
+    return _mode == AP;
+}
+
 IPAddress DemobotNetwork::getIPAddress() const {
     return _ipAddress;
 }
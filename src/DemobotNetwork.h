@@ -1,7 +1,7 @@
 /**
  * File: DemobotNetwork.h
  * Author: Matthew Yu
- * Last Modified: 03/16/21
+ * Last Modified: 10/18/26
  * Project: Demobots General
  * Organization: UT IEEE RAS
  * Description: Implements definitions for the DemobotNetwork class, which
@@ -17,6 +17,8 @@
 #define RETRY_WAIT 200      /** 200 ms. */
 #define RETRY_AMOUNT 3
 #define MAX_STRING_SIZE 20
+#define SCAN_TIME_PER_CHANNEL 100   /** 100 ms. */
+#define HOST_CHANNEL 1              /** Channel every robot hosts on. */
 
 extern IPAddress gateway;
 extern IPAddress subnet;
@@ -57,6 +59,38 @@ class DemobotNetwork {
          */
         void reconfigureNetworks();
 
+        /**
+         * Takes over as the access point for the current network, or the
+         * first entry of the credentials log if we have no network yet. Used
+         * when this robot is elected to replace a host that dropped. Call
+         * connectNetwork() afterwards to start the access point.
+         */
+        void hostNetwork();
+
+        /**
+         * Rejoins the current network in station mode. Unlike connectNetwork(),
+         * this does not wait for the connection, since the new host may still
+         * be bringing up its access point.
+         *
+         * @return True if we have a network to rejoin, false otherwise.
+         */
+        bool rejoinNetwork();
+
+        /**
+         * Scans HOST_CHANNEL for the current network. Used to check whether
+         * the host's access point is still up, whether another robot has
+         * already taken over, or whether another robot is also hosting.
+         * Only scanning one channel keeps this to about
+         * SCAN_TIME_PER_CHANNEL.
+         *
+         * @param[out] hosts Bitmask of the robots, by ID, whose access point
+         *                   is visible. Robots are told apart by their BSSID.
+         * @return True if the network is visible or the scan failed, false
+         *         if the network is gone.
+         * @note This is a blocking call.
+         */
+        bool scanNetwork(uint16_t *hosts);
+
         /**
          * Attempts to connect to the network selected during object
          * instantiation. Fails if we could not find a network during object
@@ -90,6 +124,13 @@ class DemobotNetwork {
          */
         bool isNetworkConnected() const;
 
+        /**
+         * Checks to see if we're hosting the network as an access point.
+         *
+         * @return True if configured for AP mode, false otherwise.
+         */
+        bool isAccessPoint() const;
+
         /**
          * Returns the relevant server IP address.
          * 
@@ -97,6 +138,24 @@ class DemobotNetwork {
          */
         IPAddress getIPAddress() const;
 
+        /**
+         * Returns the server IP address of any Demobot. Every Demobot has its
+         * own address, so any of them can host the network.
+         *
+         * @param[in] ID Enum referencing the specific Demobot.
+         * @return Server IPAddress that corresponds to Demobot name.
+         */
+        static IPAddress getIPAddress(const DemobotID ID);
+
+        /**
+         * Returns the BSSID of a Demobot's access point. It encodes the ID, so
+         * a scan shows which robots are hosting.
+         *
+         * @param[in] ID Enum referencing the specific Demobot.
+         * @param[out] bssid 6 byte MAC address.
+         */
+        static void getBSSID(const DemobotID ID, uint8_t bssid[6]);
+
         /**
          * Converts an IPAddress to a string.
          * @author: apicquot from https://forum.arduino.cc/index.php?topic=228884.0
@@ -123,6 +182,9 @@ class DemobotNetwork {
         /** IP address of server to connect to or host. */
         IPAddress _ipAddress;
 
+        /** ID of this robot. */
+        DemobotID _ID;
+
         /** Network info */
         char* _SSID;
         char* _PASSWORD;
@@ -1,7 +1,7 @@
 /**
  * File: DemobotServer.cpp
  * Author: Matthew Yu
- * Last Modified: 03/16/21
+ * Last Modified: 10/18/26
  * Project: Demobots General
  * Organization: UT IEEE RAS
  * Description: Implements definitions for the DemobotServer class, which
@@ -96,8 +96,51 @@ bool DemobotServer::addOnNotFound(const serverCallbackPtr_t handler) {
     return false;
 }
 
+bool DemobotServer::mountAssets(const DemobotAsset assets[], const int numAssets) {
+    if (_server == nullptr) return false;
+
+    for (int i = 0; i < numAssets; i++) {
+        const DemobotAsset *asset = &assets[i];
+        ArRequestHandlerFunction handler = [asset](AsyncWebServerRequest *request) {
+            sendAsset(request, asset);
+        };
+        _server->on(asset->path, HTTP_GET, handler);
+        if (strcmp(asset->path, "/index.html") == 0) {
+            _server->on("/", HTTP_GET, handler);
+        }
+    }
+    return true;
+}
+
+unsigned int DemobotServer::getPort() const {
+    return _port;
+}
+
 DemobotServer::~DemobotServer() {
     stopServer();
     delete _server;
     delete _request;
-}
\ No newline at end of file
+}
+
+/** Private methods. */
+
+void DemobotServer::sendAsset(AsyncWebServerRequest *request, const DemobotAsset *asset) {
+    /* Skip the body if the client already has this version. */
+    AsyncWebServerResponse *response;
+    if (request->hasHeader("If-None-Match") &&
+        request->header("If-None-Match").equals(asset->etag)) {
+        response = request->beginResponse(304);
+    } else {
+        /* Stream from flash without copying into RAM. */
+        response = request->beginResponse_P(
+            200, asset->contentType, asset->data, asset->length);
+        if (asset->isGzipped) response->addHeader("Content-Encoding", "gzip");
+    }
+
+    /* Only a hashed URL is safe to cache without checking, since a new
+     * firmware serves changed files at new URLs. Resent on 304s so the
+     * client's cached copy stays fresh. */
+    response->addHeader("ETag", asset->etag);
+    response->addHeader("Cache-Control", asset->isVersioned ? ASSET_CACHE_CONTROL : "no-cache");
+    request->send(response);
+}
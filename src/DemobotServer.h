@@ -1,7 +1,7 @@
 /**
  * File: DemobotServer.h
  * Author: Matthew Yu
- * Last Modified: 03/16/21
+ * Last Modified: 10/18/26
  * Project: Demobots General
  * Organization: UT IEEE RAS
  * Description: Implements definitions for the DemobotServer class, which
@@ -13,8 +13,43 @@
 #include <asyncHTTPrequest.h>
 
 
+#define ASSET_CACHE_CONTROL "public, max-age=31536000, immutable"   /** 1 year. */
+
 typedef void (serverCallbackPtr_t)(AsyncWebServerRequest *request);
 
+/**
+ * A file stored in flash. Arrays of these are generated by
+ * tools/pack_assets.py.
+ */
+struct DemobotAsset {
+    /** Endpoint the asset is served at. (i.e. /index.html, /app.1a2b3c4d.js) */
+    const char *path;
+
+    /** MIME type of the uncompressed file. */
+    const char *contentType;
+
+    /** Quoted hash of the uncompressed file, used as the ETag. */
+    const char *etag;
+
+    /** Contents, in PROGMEM. */
+    const uint8_t *data;
+
+    /** Length of data. */
+    size_t length;
+
+    /**
+     * Whether data is gzip compressed. Formats that are already compressed,
+     * like images and fonts, are stored as is.
+     */
+    bool isGzipped;
+
+    /**
+     * Whether the path contains a hash of the contents, so a changed file is
+     * always served at a new URL.
+     */
+    bool isVersioned;
+};
+
 class DemobotServer {
     /**
      * The DemobotServer class allows the Demobot to set up a web server and
@@ -86,8 +121,39 @@ class DemobotServer {
          */
         bool addOnNotFound(const serverCallbackPtr_t handler);
 
+        /**
+         * Adds a GET endpoint for each asset in a bundle generated by
+         * tools/pack_assets.py. Assets are streamed straight from flash,
+         * with "Content-Encoding: gzip" if they are gzipped. Versioned
+         * assets are cached for ASSET_CACHE_CONTROL, and everything else is
+         * revalidated on every load using its ETag. If the bundle has an /index.html, it is also served at '/'.
+         *
+         * @param[in] assets Array of assets. Must outlive the server.
+         * @param[in] numAssets Number of assets in the array.
+         * @return True if the assets were mounted. False otherwise.
+         * @note Endpoints added earlier take precedence over the bundle.
+         */
+        bool mountAssets(const DemobotAsset assets[], const int numAssets);
+
+        /**
+         * Returns the port the server was opened on.
+         *
+         * @return Server port.
+         */
+        unsigned int getPort() const;
+
         ~DemobotServer();
 
+    private:
+        /**
+         * Sends an asset, or 304 Not Modified if the client's cached copy
+         * is current.
+         *
+         * @param[in] request Client request for the asset.
+         * @param[in] asset The asset to send.
+         */
+        static void sendAsset(AsyncWebServerRequest *request, const DemobotAsset *asset);
+
     private:
         /** Port for webserver to open on. */
         unsigned int _port;
@@ -0,0 +1,522 @@
+/**
+ * File: test_election.cpp
+ * Author: agent
+ * Last Modified: 10/18/26
+ * Project: Demobots General
+ * Organization: UT IEEE RAS
+ * Description: Runs DemobotElection on simulated robots on Linux. Each
+ * scenario kills or disturbs robots and checks that exactly one robot ends up
+ * hosting, printing the recovery time of each failover. Heartbeats, request
+ * timeouts, scans and joining an access point take about as long as they do
+ * on the robots, so the recovery times are comparable.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "DemobotElection.h"
+
+
+/** Same IDs and priorities as DemobotNetwork and DemobotFailover. */
+enum { DANCEBOT_1, DANCEBOT_2, DANCEBOT_3, DANCEBOT_4, DANCEBOT_5,
+       MOTHERSHIP, POLARGRAPH, MARQUEE, TOWER_OF_POWER, NUM_IDS };
+
+const uint8_t hostPriority[] = {
+    MOTHERSHIP, DANCEBOT_1, DANCEBOT_2, DANCEBOT_3, DANCEBOT_4, DANCEBOT_5,
+    POLARGRAPH, MARQUEE, TOWER_OF_POWER
+};
+
+#define TICK 10                 /** 10 ms. */
+#define AP_STARTUP 200          /** Time for a new access point to come up. */
+#define JOIN_TIME 1000          /** Time for a station to join an access point. */
+#define LATENCY 20              /** Round trip of a request that gets through. */
+#define REQUEST_TIMEOUT 1500    /** HEARTBEAT_TIMEOUT, checked every 500 ms. */
+#define SCAN_TIME 150           /** HOST_CHANNEL at SCAN_TIME_PER_CHANNEL. */
+#define FULL_SCAN_TIME 1400     /** Every channel at SCAN_TIME_PER_CHANNEL. */
+#define FOREVER 0xFFFFFFFF
+
+const char *names[] = {
+    "DANCEBOT_1", "DANCEBOT_2", "DANCEBOT_3", "DANCEBOT_4", "DANCEBOT_5",
+    "MOTHERSHIP", "POLARGRAPH", "MARQUEE", "TOWER_OF_POWER"
+};
+
+/** A heartbeat or probe. One of each may be in flight. */
+struct Request {
+    bool isPending;
+    uint8_t target;
+    uint8_t vouch;
+
+    /** Whether the target was on the same access point when it was sent. */
+    bool isReachable;
+
+    /** Time it was sent, and time it gets a response or times out. */
+    uint32_t sendTime;
+    uint32_t doneTime;
+};
+
+/** A simulated robot. */
+struct Node {
+    DemobotElection *election;
+    bool isAlive;
+
+    /** Time its access point is visible from, while it is host. */
+    uint32_t apTime;
+
+    /** Access point it is joining or has joined as a station, or NO_NODE. */
+    uint8_t ap;
+
+    /** Time its station link comes up. */
+    uint32_t linkTime;
+
+    /** Time its link is down until, to simulate a glitch. */
+    uint32_t blipUntil;
+
+    /** Whether it is blocked in a scan, and until when. */
+    bool isScanning;
+    uint32_t scanTime;
+
+    Request heartbeat;
+    Request probe;
+
+    /** Number of times it dropped its link to rejoin the network. */
+    int numRejoins;
+};
+
+/** A simulated network of robots sharing one SSID. */
+struct Network {
+    Node nodes[NUM_IDS];
+    uint32_t now;
+
+    /** How long a scan blocks the robot for. */
+    uint32_t scanTime;
+
+    /** Whether scans only show that the network is up, not who hosts it. */
+    bool isBSSIDHidden;
+
+    /** Whether more than one access point has ever been up at once. */
+    bool isSplit;
+
+    /** Access point stations should prefer when several are up. */
+    uint8_t preferredAP;
+};
+
+int failures = 0;
+
+#define CHECK(cond) do { \
+    if (!(cond)) { \
+        printf("    FAILED %s:%d: %s\n", __FILE__, __LINE__, #cond); \
+        failures++; \
+    } \
+} while (0)
+
+bool isAfter(uint32_t a, uint32_t b) {
+    return (int32_t)(a - b) > 0;
+}
+
+void init(Network &net, uint32_t start) {
+    for (int i = 0; i < NUM_IDS; i++) {
+        net.nodes[i].election = nullptr;
+        net.nodes[i].isAlive = false;
+    }
+    net.now = start;
+    net.scanTime = SCAN_TIME;
+    net.isBSSIDHidden = false;
+    net.isSplit = false;
+    net.preferredAP = NO_NODE;
+}
+
+void addNode(Network &net, uint8_t id, DemobotElection::Role role) {
+    Node &node = net.nodes[id];
+    node.election = new DemobotElection(id, hostPriority, NUM_IDS, role, net.now);
+    node.isAlive = true;
+    node.apTime = (role == DemobotElection::HOST) ? net.now : FOREVER;
+    node.ap = NO_NODE;
+    node.linkTime = net.now;
+    node.blipUntil = net.now;
+    node.isScanning = false;
+    node.heartbeat.isPending = false;
+    node.heartbeat.sendTime = net.now - HEARTBEAT_INTERVAL;
+    node.probe.isPending = false;
+    node.probe.sendTime = net.now - HEARTBEAT_INTERVAL;
+    node.numRejoins = 0;
+}
+
+void kill(Network &net, uint8_t id) {
+    net.nodes[id].isAlive = false;
+}
+
+void teardown(Network &net) {
+    for (int i = 0; i < NUM_IDS; i++) delete net.nodes[i].election;
+}
+
+bool isAPUp(const Network &net, int id) {
+    const Node &node = net.nodes[id];
+    return node.isAlive && node.election != nullptr &&
+        node.election->getRole() == DemobotElection::HOST &&
+        node.apTime != FOREVER && !isAfter(node.apTime, net.now);
+}
+
+bool isLinkUp(const Network &net, int id) {
+    const Node &node = net.nodes[id];
+    return node.election->getRole() == DemobotElection::MEMBER && node.ap != NO_NODE &&
+        !isAfter(node.linkTime, net.now) && !isAfter(node.blipUntil, net.now);
+}
+
+/** Returns the access point a robot's traffic goes through, or NO_NODE. */
+uint8_t getAP(const Network &net, int id) {
+    if (!net.nodes[id].isAlive) return NO_NODE;
+    if (isAPUp(net, id)) return id;
+    if (isLinkUp(net, id)) return net.nodes[id].ap;
+    return NO_NODE;
+}
+
+bool isReachable(const Network &net, int id, uint8_t target) {
+    uint8_t ap = getAP(net, id);
+    return ap != NO_NODE && getAP(net, target) == ap;
+}
+
+/** Returns a visible access point other than self, or NO_NODE. */
+uint8_t findAP(const Network &net, int self) {
+    if (net.preferredAP != NO_NODE && net.preferredAP != self && isAPUp(net, net.preferredAP)) {
+        return net.preferredAP;
+    }
+    for (int i = 0; i < NUM_IDS; i++) {
+        if (i != self && isAPUp(net, i)) return i;
+    }
+    return NO_NODE;
+}
+
+/** Returns the access points other than self that a scan would see. */
+uint16_t findHosts(const Network &net, int self) {
+    uint16_t hosts = 0;
+    for (int i = 0; i < NUM_IDS; i++) {
+        if (i != self && isAPUp(net, i)) hosts |= 1 << i;
+    }
+    return hosts;
+}
+
+void handleAction(Network &net, int id, DemobotElection::Action action) {
+    Node &node = net.nodes[id];
+    if (action == DemobotElection::SCAN_NETWORK) {
+        /* The scan blocks the loop. Its result is handled when it ends. */
+        node.isScanning = true;
+        node.scanTime = net.now + net.scanTime;
+        return;
+    }
+
+    /* DemobotFailover closes every connection, dropping requests in flight. */
+    if (action == DemobotElection::BECOME_HOST || action == DemobotElection::JOIN_HOST) {
+        node.heartbeat.isPending = false;
+        node.probe.isPending = false;
+    }
+    if (action == DemobotElection::BECOME_HOST) {
+        node.apTime = net.now + AP_STARTUP;
+        node.ap = NO_NODE;
+    } else if (action == DemobotElection::JOIN_HOST) {
+        node.apTime = FOREVER;
+        node.ap = NO_NODE;
+        node.numRejoins++;
+    }
+}
+
+void sendRequest(Network &net, int id, Request &request, uint8_t target) {
+    request.isPending = true;
+    request.target = target;
+    request.vouch = net.nodes[id].election->getConfirmedHost(net.now);
+    request.isReachable = isReachable(net, id, target);
+    request.sendTime = net.now;
+    request.doneTime = net.now + (request.isReachable ? LATENCY : REQUEST_TIMEOUT);
+}
+
+/** Delivers a request once its response is due, if it got through. */
+void handleRequest(Network &net, int id, Request &request) {
+    if (!request.isPending || isAfter(request.doneTime, net.now)) return;
+    request.isPending = false;
+    if (!request.isReachable || !isReachable(net, id, request.target)) return;
+
+    DemobotElection *target = net.nodes[request.target].election;
+    target->onHeartbeat(id, request.vouch, net.now);
+    if (target->getRole() == DemobotElection::HOST) {
+        net.nodes[id].election->onHostResponse(request.target, target->getMembers(), net.now);
+    }
+}
+
+/** Whether no request is in flight and HEARTBEAT_INTERVAL has passed. */
+bool isDue(const Network &net, const Request &request) {
+    return !request.isPending && !isAfter(request.sendTime + HEARTBEAT_INTERVAL, net.now);
+}
+
+void step(Network &net) {
+    net.now += TICK;
+
+    for (int id = 0; id < NUM_IDS; id++) {
+        Node &node = net.nodes[id];
+        if (!node.isAlive) continue;
+        DemobotElection *election = node.election;
+
+        /* Stations lose their link when the access point goes away, and
+         * join any access point on the SSID. */
+        if (election->getRole() == DemobotElection::MEMBER) {
+            if (node.ap != NO_NODE && !isAPUp(net, node.ap)) node.ap = NO_NODE;
+            if (node.ap == NO_NODE) {
+                node.ap = findAP(net, id);
+                node.linkTime = net.now + JOIN_TIME;
+            }
+        }
+
+        /* Responses arrive on the AsyncTCP task, even during a scan. */
+        handleRequest(net, id, node.heartbeat);
+        handleRequest(net, id, node.probe);
+
+        if (node.isScanning) {
+            if (isAfter(node.scanTime, net.now)) continue;
+            node.isScanning = false;
+            uint16_t hosts = findHosts(net, id);
+            handleAction(net, id, election->onNetworkScan(
+                hosts != 0, net.isBSSIDHidden ? 0 : hosts, net.now));
+            continue;
+        }
+
+        bool isUp = isLinkUp(net, id);
+        handleAction(net, id, election->update(net.now, isUp));
+        if (!isLinkUp(net, id) || node.isScanning) continue;
+
+        /* Heartbeat the host and probe for it, one of each at a time. */
+        uint8_t target = isDue(net, node.heartbeat) ? election->getHeartbeatTarget() : NO_NODE;
+        uint8_t probe = isDue(net, node.probe) ? election->getProbeTarget() : NO_NODE;
+        if (target != NO_NODE) sendRequest(net, id, node.heartbeat, target);
+        if (probe != NO_NODE) sendRequest(net, id, node.probe, probe);
+    }
+
+    int numAPs = 0;
+    for (int id = 0; id < NUM_IDS; id++) {
+        if (isAPUp(net, id)) numAPs++;
+    }
+    if (numAPs > 1) net.isSplit = true;
+}
+
+void run(Network &net, uint32_t duration) {
+    uint32_t end = net.now + duration;
+    while (isAfter(end, net.now)) step(net);
+}
+
+/** Checks that exactly one robot hosts and every other live robot follows it. */
+void checkSingleHost(Network &net, uint8_t expected) {
+    int numHosts = 0;
+    for (int id = 0; id < NUM_IDS; id++) {
+        Node &node = net.nodes[id];
+        if (!node.isAlive) continue;
+        if (node.election->getRole() == DemobotElection::HOST) {
+            numHosts++;
+            CHECK(id == expected);
+        } else {
+            CHECK(node.election->getHost() == expected);
+            CHECK(node.election->getConfirmedHost(net.now) == expected);
+            CHECK(node.ap == expected);
+        }
+    }
+    CHECK(numHosts == 1);
+}
+
+/** Checks that no live robot dropped its link to rejoin more than max times. */
+void checkRejoins(Network &net, int max) {
+    for (int id = 0; id < NUM_IDS; id++) {
+        if (net.nodes[id].isAlive) CHECK(net.nodes[id].numRejoins <= max);
+    }
+}
+
+void printRecovery(Network &net) {
+    for (int id = 0; id < NUM_IDS; id++) {
+        Node &node = net.nodes[id];
+        if (!node.isAlive) continue;
+        printf("    %-14s %-6s recovery %5u ms, %d rejoins\n", names[id],
+            node.election->getRole() == DemobotElection::HOST ? "host" : "member",
+            node.election->getRecoveryTime(), node.numRejoins);
+    }
+}
+
+/** Sets up a settled network with the given host and members. */
+void settle(Network &net, uint32_t start, uint8_t host, const uint8_t members[], int numMembers) {
+    init(net, start);
+    addNode(net, host, DemobotElection::HOST);
+    for (int i = 0; i < numMembers; i++) addNode(net, members[i], DemobotElection::MEMBER);
+    run(net, 3000);
+    checkSingleHost(net, host);
+    for (int i = 0; i < NUM_IDS; i++) net.nodes[i].numRejoins = 0;
+}
+
+void testFailover(uint32_t start, uint32_t scanTime, bool isBSSIDHidden) {
+    printf("Host fails (start time %u, %u ms scans%s):\n", start, scanTime,
+        isBSSIDHidden ? ", hosts unknown to scans" : "");
+    Network net;
+    const uint8_t members[] = {DANCEBOT_1, DANCEBOT_2, POLARGRAPH, MARQUEE};
+    settle(net, start, MOTHERSHIP, members, 4);
+    net.scanTime = scanTime;
+    net.isBSSIDHidden = isBSSIDHidden;
+
+    kill(net, MOTHERSHIP);
+    run(net, 15000);
+    checkSingleHost(net, DANCEBOT_1);
+    checkRejoins(net, 1);
+    CHECK(!net.isSplit);
+    CHECK(net.nodes[DANCEBOT_1].election->getRecoveryTime() > 0);
+    printRecovery(net);
+    teardown(net);
+}
+
+void testCascade() {
+    printf("Host and its successor fail together:\n");
+    Network net;
+    const uint8_t members[] = {DANCEBOT_1, DANCEBOT_2, MARQUEE};
+    settle(net, 0, MOTHERSHIP, members, 3);
+
+    kill(net, MOTHERSHIP);
+    kill(net, DANCEBOT_1);
+    run(net, 30000);
+    checkSingleHost(net, DANCEBOT_2);
+    checkRejoins(net, 2);
+    CHECK(!net.isSplit);
+    printRecovery(net);
+    teardown(net);
+}
+
+void testInconsistentMembers(bool isBSSIDHidden) {
+    printf("Host fails right after a higher priority member joins%s:\n",
+        isBSSIDHidden ? " (hosts unknown to scans)" : "");
+    Network net;
+    const uint8_t members[] = {DANCEBOT_2, MARQUEE};
+    settle(net, 0, MOTHERSHIP, members, 2);
+    net.isBSSIDHidden = isBSSIDHidden;
+
+    /* DANCEBOT_1 joins; kill the host as soon as it responds, before the
+     * other members hear about DANCEBOT_1. */
+    addNode(net, DANCEBOT_1, DemobotElection::MEMBER);
+    net.nodes[DANCEBOT_1].ap = MOTHERSHIP;
+    while (net.nodes[DANCEBOT_1].election->getConfirmedHost(net.now) == NO_NODE) step(net);
+    kill(net, MOTHERSHIP);
+    CHECK(!(net.nodes[DANCEBOT_2].election->getMembers() & (1 << DANCEBOT_1)));
+    CHECK(net.nodes[DANCEBOT_1].election->getMembers() & (1 << DANCEBOT_2));
+
+    run(net, 15000);
+    checkSingleHost(net, DANCEBOT_1);
+    checkRejoins(net, 2);
+    CHECK(!net.isSplit);
+    printRecovery(net);
+    teardown(net);
+}
+
+void testLateJoiner(bool isBSSIDHidden) {
+    printf("Robot joins while a robot other than MOTHERSHIP hosts%s:\n",
+        isBSSIDHidden ? " (hosts unknown to scans)" : "");
+    Network net;
+    const uint8_t members[] = {MARQUEE};
+    settle(net, 0, DANCEBOT_3, members, 1);
+    net.isBSSIDHidden = isBSSIDHidden;
+
+    /* Without a scan to go on, it probes past the robots that are off, each
+     * of which takes a request timeout. */
+    uint32_t start = net.now;
+    addNode(net, POLARGRAPH, DemobotElection::MEMBER);
+    while (net.nodes[POLARGRAPH].election->getConfirmedHost(net.now) == NO_NODE &&
+           isAfter(start + 15000, net.now)) {
+        step(net);
+    }
+    printf("    POLARGRAPH     found the host after %u ms\n", net.now - start);
+    CHECK(isAfter(start + 10000, net.now));
+    run(net, 5000);
+    checkSingleHost(net, DANCEBOT_3);
+    checkRejoins(net, 0);
+    CHECK(!net.isSplit);
+    teardown(net);
+
+    printf("Robot joins a network whose host has already failed:\n");
+    settle(net, 0, DANCEBOT_3, members, 1);
+    kill(net, DANCEBOT_3);
+    kill(net, MARQUEE);
+    addNode(net, POLARGRAPH, DemobotElection::MEMBER);
+    run(net, 10000);
+    CHECK(net.nodes[POLARGRAPH].election->getRole() == DemobotElection::MEMBER);
+    teardown(net);
+}
+
+void testLinkGlitch() {
+    printf("Member's link drops while the host is fine:\n");
+    Network net;
+    const uint8_t members[] = {DANCEBOT_1, DANCEBOT_2};
+    settle(net, 0, MOTHERSHIP, members, 2);
+
+    net.nodes[DANCEBOT_1].blipUntil = net.now + 1500;
+    run(net, 10000);
+    checkSingleHost(net, MOTHERSHIP);
+    checkRejoins(net, 1);
+    CHECK(!net.isSplit);
+    teardown(net);
+}
+
+void testSplitBrain() {
+    printf("Two hosts; a member moves from the better one to the other:\n");
+    Network net;
+    init(net, 0);
+    addNode(net, DANCEBOT_1, DemobotElection::HOST);
+    addNode(net, DANCEBOT_3, DemobotElection::HOST);
+    addNode(net, MARQUEE, DemobotElection::MEMBER);
+    net.preferredAP = DANCEBOT_1;
+    run(net, 2000);
+    CHECK(net.nodes[MARQUEE].election->getHost() == DANCEBOT_1);
+
+    /* Roam to the lower priority host, which should step down. */
+    net.preferredAP = DANCEBOT_3;
+    net.nodes[MARQUEE].ap = DANCEBOT_3;
+    run(net, 10000);
+    checkSingleHost(net, DANCEBOT_1);
+    teardown(net);
+}
+
+void testBootRace() {
+    printf("Two robots boot at once and both start hosting:\n");
+    Network net;
+    init(net, 0);
+    addNode(net, DANCEBOT_1, DemobotElection::HOST);
+    addNode(net, DANCEBOT_3, DemobotElection::HOST);
+    addNode(net, MARQUEE, DemobotElection::MEMBER);
+    addNode(net, POLARGRAPH, DemobotElection::MEMBER);
+
+    /* Each member stays on the access point it found first. */
+    net.nodes[MARQUEE].ap = DANCEBOT_3;
+    net.nodes[POLARGRAPH].ap = DANCEBOT_1;
+    run(net, 10000);
+    checkSingleHost(net, DANCEBOT_1);
+    checkRejoins(net, 1);
+    printRecovery(net);
+    teardown(net);
+}
+
+void testResponseAfterNow() {
+    printf("Response timestamped after the caller sampled the time:\n");
+    const uint8_t priority[] = {MOTHERSHIP, DANCEBOT_1};
+    DemobotElection election(DANCEBOT_1, priority, 2, DemobotElection::MEMBER, 0);
+    election.onHostResponse(MOTHERSHIP, (1 << MOTHERSHIP) | (1 << DANCEBOT_1), 5001);
+    CHECK(election.update(5000, true) == DemobotElection::NONE);
+    CHECK(election.getRole() == DemobotElection::MEMBER);
+}
+
+int main() {
+    testFailover(0, SCAN_TIME, false);
+    testFailover(0xFFFFF000, SCAN_TIME, false);
+    testFailover(0, FULL_SCAN_TIME, true);
+    testCascade();
+    testInconsistentMembers(false);
+    testInconsistentMembers(true);
+    testLateJoiner(false);
+    testLateJoiner(true);
+    testLinkGlitch();
+    testSplitBrain();
+    testBootRace();
+    testResponseAfterNow();
+
+    if (failures > 0) {
+        printf("%d checks failed.\n", failures);
+        return EXIT_FAILURE;
+    }
+    printf("All checks passed.\n");
+    return EXIT_SUCCESS;
+}
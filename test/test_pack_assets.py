@@ -0,0 +1,120 @@
+#!/usr/bin/env python3
+"""
+File: test_pack_assets.py
+Author: agent
+Last Modified: 10/18/26
+Project: Demobots General
+Organization: UT IEEE RAS
+Description: Packs small asset directories with tools/pack_assets.py and
+checks the generated header: which files are renamed, that every reference
+still resolves, and which files are gzipped.
+"""
+import gzip
+import os
+import re
+import sys
+import tempfile
+import unittest
+
+sys.dont_write_bytecode = True
+sys.path.insert(0, os.path.join(os.path.dirname(os.path.abspath(__file__)), "..", "tools"))
+import pack_assets  # noqa: E402
+
+
+ENTRY = re.compile(r'\{"([^"]*)", "([^"]*)", "(?:[^"\\]|\\.)*", (\w+), (\d+), (true|false), (true|false)\}')
+ARRAY = re.compile(r"const uint8_t (\w+)\[\] PROGMEM = \{(.*?)\};", re.S)
+
+
+def pack(files):
+    """Packs a directory of files and returns {path: (contents, is_gzipped, is_versioned)}."""
+    with tempfile.TemporaryDirectory() as root:
+        for path, contents in files.items():
+            path = os.path.join(root, path)
+            os.makedirs(os.path.dirname(path), exist_ok=True)
+            with open(path, "wb") as f:
+                f.write(contents)
+        header, _, _, _ = pack_assets.pack(root, "assets")
+
+    arrays = {}
+    for match in ARRAY.finditer(header):
+        arrays[match.group(1)] = bytes(int(b, 16) for b in re.findall(r"0x([0-9a-f]{2})", match.group(2)))
+
+    assets = {}
+    for path, _, array, length, is_gzipped, is_versioned in ENTRY.findall(header):
+        data = arrays[array]
+        assert len(data) == int(length)
+        if is_gzipped == "true":
+            data = gzip.decompress(data)
+        assets[path] = (data, is_gzipped == "true", is_versioned == "true")
+    return assets
+
+
+def find(assets, prefix, ext):
+    """Returns the path of the asset renamed from prefix + ext."""
+    pattern = re.compile(re.escape(prefix) + r"\.[0-9a-f]{8}" + re.escape(ext) + "$")
+    matches = [path for path in assets if pattern.match(path)]
+    assert len(matches) == 1, matches
+    return matches[0]
+
+
+class TestPackAssets(unittest.TestCase):
+    def test_cross_linked_pages(self):
+        assets = pack({
+            "index.html": b'<link rel="stylesheet" href="a.css"><a href="settings.html">Settings</a>'
+                          b'<img src="img/bg.png">',
+            "settings.html": b'<a href="/index.html">Back</a><link href="a.css" rel="stylesheet">',
+            "a.css": b'@import url("b.css"); h1 { color: red; }',
+            "b.css": b'@import "c.css"; body { background: url(img/bg.png?v=1#x); }',
+            "c.css": b'p { background: url("/img/bg.png"); }',
+            "img/bg.png": b"PNG",
+            "favicon.ico": b"ICO",
+        })
+
+        # Pages keep their names, so '/' and page links still work.
+        index, _, is_versioned = assets["/index.html"]
+        self.assertFalse(is_versioned)
+        settings, _, is_versioned = assets["/settings.html"]
+        self.assertFalse(is_versioned)
+        self.assertIn(b'<a href="settings.html">', index)
+        self.assertIn(b'<a href="/index.html">', settings)
+
+        # Subresources are renamed, and every reference points at them.
+        a = find(assets, "/a", ".css")
+        b = find(assets, "/b", ".css")
+        c = find(assets, "/c", ".css")
+        bg = find(assets, "/img/bg", ".png")
+        self.assertIn(('href="%s"' % a).encode(), index)
+        self.assertIn(('href="%s"' % a).encode(), settings)
+        self.assertIn(('src="%s"' % bg).encode(), index)
+        self.assertIn(('url("%s")' % b).encode(), assets[a][0])
+        self.assertIn(('@import "%s"' % c).encode(), assets[b][0])
+        self.assertIn(("url(%s?v=1#x)" % bg).encode(), assets[b][0])
+        self.assertIn(('url("%s")' % bg).encode(), assets[c][0])
+        for path in (a, b, c, bg):
+            self.assertTrue(assets[path][2])
+
+        # Unreferenced files keep their names and are revalidated.
+        self.assertFalse(assets["/favicon.ico"][2])
+        self.assertEqual(len(assets), 7)
+
+    def test_stylesheet_cycle(self):
+        with self.assertRaises(pack_assets.PackError):
+            pack({
+                "index.html": b'<link href="a.css">',
+                "a.css": b'@import "b.css";',
+                "b.css": b'@import url(a.css);',
+            })
+
+    def test_compression(self):
+        assets = pack({
+            "photo.jpg": b"JPEG" * 64,
+            "tiny.txt": b"x",
+            "app.js": b"console.log('hello');\n" * 16,
+        })
+        self.assertEqual(assets["/photo.jpg"][:2], (b"JPEG" * 64, False))
+        self.assertEqual(assets["/tiny.txt"][:2], (b"x", False))
+        self.assertEqual(assets["/app.js"][:2], (b"console.log('hello');\n" * 16, True))
+
+
+if __name__ == "__main__":
+    unittest.main()
@@ -0,0 +1,297 @@
+#!/usr/bin/env python3
+"""
+File: pack_assets.py
+Author: agent
+Last Modified: 10/18/26
+Project: Demobots General
+Organization: UT IEEE RAS
+Description: Packs a directory of web assets into a C++ header of PROGMEM
+arrays and a DemobotAsset index, which can be served with
+DemobotServer::mountAssets(). Files are gzip compressed unless they are
+already compressed (i.e. images and fonts) or gzip would make them larger.
+
+Subresources loaded by HTML (<link href>, src) or CSS (url(), @import) are
+renamed to include a hash of their contents (i.e. /app.js becomes
+/app.1a2b3c4d.js) and the references are rewritten to match. A new firmware
+therefore serves new URLs, so those assets can be cached for a long time.
+HTML pages and anything not referenced keep their path and are revalidated by
+the browser on every load.
+
+Usage: python3 tools/pack_assets.py <asset directory> <output header> [--name NAME]
+"""
+import argparse
+import gzip
+import hashlib
+import mimetypes
+import os
+import posixpath
+import re
+
+# Types mimetypes may not know about or gets wrong on some platforms.
+CONTENT_TYPES = {
+    ".html": "text/html",
+    ".css": "text/css",
+    ".js": "application/javascript",
+    ".json": "application/json",
+    ".svg": "image/svg+xml",
+    ".ico": "image/x-icon",
+    ".png": "image/png",
+    ".jpg": "image/jpeg",
+    ".woff2": "font/woff2",
+}
+
+# Formats that are already compressed, so gzip only adds overhead.
+COMPRESSED_EXTENSIONS = {
+    ".png", ".jpg", ".jpeg", ".gif", ".webp", ".woff", ".woff2",
+    ".gz", ".zip", ".mp3", ".mp4",
+}
+
+HTML_EXTENSIONS = (".html", ".htm")
+
+HTML_TAG = re.compile(rb"<([a-zA-Z][a-zA-Z0-9]*)(\s[^>]*)>")
+HTML_ATTRIBUTE = re.compile(rb"""(\b(src|href)\s*=\s*)(["'])([^"']*)\3""", re.IGNORECASE)
+CSS_REFERENCE = re.compile(
+    rb"""(\burl\(\s*)(["']?)([^"')]*)\2(?=\s*\))|(@import\s+)(["'])([^"']*)\5""",
+    re.IGNORECASE)
+
+
+class PackError(Exception):
+    pass
+
+
+def get_content_type(path):
+    ext = os.path.splitext(path)[1].lower()
+    if ext in CONTENT_TYPES:
+        return CONTENT_TYPES[ext]
+    guess, _ = mimetypes.guess_type(path)
+    return guess or "application/octet-stream"
+
+
+def is_html(endpoint):
+    return endpoint.lower().endswith(HTML_EXTENSIONS)
+
+
+def is_css(endpoint):
+    return endpoint.lower().endswith(".css")
+
+
+def find_assets(root):
+    """Returns (endpoint, file path) pairs for every non-hidden file, sorted."""
+    assets = []
+    for dirpath, dirnames, filenames in os.walk(root):
+        dirnames[:] = sorted(d for d in dirnames if not d.startswith("."))
+        for filename in sorted(filenames):
+            if filename.startswith("."):
+                continue
+            path = os.path.join(dirpath, filename)
+            endpoint = "/" + os.path.relpath(path, root).replace(os.sep, "/")
+            assets.append((endpoint, path))
+    return assets
+
+
+def resolve(endpoint, reference):
+    """Returns the endpoint a reference points to and its query/fragment."""
+    url = reference.decode("utf-8", "replace")
+    split = min([i for i in (url.find("?"), url.find("#")) if i >= 0] or [len(url)])
+    url, suffix = url[:split], url[split:]
+    if not url or ":" in url.split("/")[0] or url.startswith("//"):
+        return None, suffix
+    if not url.startswith("/"):
+        url = posixpath.join(posixpath.dirname(endpoint), url)
+    return posixpath.normpath(url), suffix
+
+
+def map_references(endpoint, raw, replace):
+    """
+    Calls replace(reference) for every subresource a file loads and
+    substitutes what it returns. Page links such as <a href> are not
+    subresources and are left alone.
+    """
+    if is_html(endpoint):
+        def replace_attribute(match):
+            name = match.group(2).lower()
+            if name == b"href" and tag != b"link":
+                return match.group(0)
+            return match.group(1) + match.group(3) + replace(match.group(4)) + match.group(3)
+
+        def replace_tag(match):
+            nonlocal tag
+            tag = match.group(1).lower()
+            return b"<" + match.group(1) + HTML_ATTRIBUTE.sub(replace_attribute, match.group(2)) + b">"
+
+        tag = None
+        return HTML_TAG.sub(replace_tag, raw)
+
+    if is_css(endpoint):
+        def replace_css(match):
+            if match.group(1) is not None:
+                return match.group(1) + match.group(2) + replace(match.group(3)) + match.group(2)
+            return match.group(4) + match.group(5) + replace(match.group(6)) + match.group(5)
+
+        return CSS_REFERENCE.sub(replace_css, raw)
+
+    return raw
+
+
+def find_references(endpoint, raw, endpoints):
+    """Returns the assets a file loads."""
+    references = set()
+
+    def record(reference):
+        target, _ = resolve(endpoint, reference)
+        if target in endpoints and target != endpoint:
+            references.add(target)
+        return reference
+
+    map_references(endpoint, raw, record)
+    return references
+
+
+def rewrite(endpoint, raw, versions):
+    """Replaces references to versioned assets with their versioned paths."""
+    def replace(reference):
+        target, suffix = resolve(endpoint, reference)
+        if target not in versions:
+            return reference
+        return (versions[target] + suffix).encode()
+
+    return map_references(endpoint, raw, replace)
+
+
+def sort_stylesheets(stylesheets, references):
+    """
+    Orders stylesheets so each comes after the stylesheets it imports, since
+    an import can only be rewritten once its target has been hashed.
+    """
+    order = []
+    visiting = []
+
+    def visit(endpoint):
+        if endpoint in order:
+            return
+        if endpoint in visiting:
+            cycle = visiting[visiting.index(endpoint):] + [endpoint]
+            raise PackError("stylesheets import each other: %s" % " -> ".join(cycle))
+        visiting.append(endpoint)
+        for target in sorted(references[endpoint]):
+            if is_css(target):
+                visit(target)
+        visiting.pop()
+        order.append(endpoint)
+
+    for endpoint in sorted(stylesheets):
+        visit(endpoint)
+    return order
+
+
+def compress(endpoint, raw):
+    """Returns the data to store and whether it is gzip compressed."""
+    if posixpath.splitext(endpoint)[1].lower() in COMPRESSED_EXTENSIONS:
+        return raw, False
+
+    # mtime=0 keeps the output identical between builds.
+    data = gzip.compress(raw, compresslevel=9, mtime=0)
+    if len(data) >= len(raw):
+        return raw, False
+    return data, True
+
+
+def pack(root, name):
+    lines = [
+        "/**",
+        " * Generated by tools/pack_assets.py from %s. Do not edit." % os.path.basename(os.path.abspath(root)),
+        " */",
+        "#pragma once",
+        "",
+        "#include <DemobotServer.h>",
+        "",
+        "",
+    ]
+
+    files = {}
+    for endpoint, path in find_assets(root):
+        with open(path, "rb") as f:
+            files[endpoint] = (path, f.read())
+
+    # 1. find which assets are loaded by HTML or CSS. Only those can be
+    # renamed, and pages never are, since they are what users navigate to.
+    references = {}
+    for endpoint, (_, raw) in files.items():
+        references[endpoint] = find_references(endpoint, raw, files)
+    referenced = set()
+    for endpoint in files:
+        referenced |= references[endpoint]
+    referenced = set(e for e in referenced if not is_html(e))
+
+    # 2. hash every asset after the ones it references, so each reference is
+    # rewritten before its own file is hashed: leaves, then stylesheets in
+    # import order, then pages.
+    leaves = sorted(e for e in files if not is_html(e) and not is_css(e))
+    stylesheets = sort_stylesheets([e for e in files if is_css(e)], references)
+    pages = sorted(e for e in files if is_html(e))
+
+    versions = {}
+    packed = []
+    for endpoint in leaves + stylesheets + pages:
+        path, raw = files[endpoint]
+        raw = rewrite(endpoint, raw, versions)
+        digest = hashlib.sha1(raw).hexdigest()
+
+        served = endpoint
+        if endpoint in referenced:
+            base, ext = posixpath.splitext(endpoint)
+            served = "%s.%s%s" % (base, digest[:8], ext)
+            versions[endpoint] = served
+        packed.append((served, path, raw, digest, endpoint in referenced))
+
+    entries = []
+    raw_total = 0
+    packed_total = 0
+    for i, (endpoint, path, raw, digest, is_versioned) in enumerate(sorted(packed)):
+        data, is_gzipped = compress(endpoint, raw)
+        etag = '\\"%s\\"' % digest[:16]
+        array = "%s_%d_%s" % (name, i, re.sub(r"\W", "_", endpoint.strip("/")))
+
+        lines.append("/** %s: %d bytes, %d stored%s. */" % (
+            endpoint, len(raw), len(data), " gzipped" if is_gzipped else ""))
+        lines.append("const uint8_t %s[] PROGMEM = {" % array)
+        for j in range(0, len(data), 16):
+            lines.append("    " + ", ".join("0x%02x" % b for b in data[j:j + 16]) + ",")
+        lines.append("};")
+        lines.append("")
+        entries.append('    {"%s", "%s", "%s", %s, %d, %s, %s}' % (
+            endpoint, get_content_type(path), etag, array, len(data),
+            "true" if is_gzipped else "false",
+            "true" if is_versioned else "false"))
+
+        raw_total += len(raw)
+        packed_total += len(data)
+
+    lines.append("const DemobotAsset %s[] = {" % name)
+    lines.append(",\n".join(entries))
+    lines.append("};")
+    lines.append("")
+    lines.append("const int %sCount = %d;" % (name, len(entries)))
+    return "\n".join(lines) + "\n", len(entries), raw_total, packed_total
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Pack web assets for DemobotServer::mountAssets().")
+    parser.add_argument("root", help="directory of web assets")
+    parser.add_argument("output", help="header file to generate")
+    parser.add_argument("--name", default="demobotAssets", help="name of the generated asset array")
+    args = parser.parse_args()
+
+    try:
+        header, count, raw_total, packed_total = pack(args.root, args.name)
+    except PackError as error:
+        parser.error(str(error))
+    if count == 0:
+        parser.error("no assets found in %s" % args.root)
+    with open(args.output, "w") as f:
+        f.write(header)
+    print("Packed %d assets: %d bytes, %d stored." % (count, raw_total, packed_total))
+
+
+if __name__ == "__main__":
+    main()